@@ -35,24 +35,55 @@ cleanup:
 
 void handler(const gg_lambda_context *cxt) {
     gg_error err = GGE_SUCCESS;
-    char input[MESSAGE_SIZE];
-    char output[MESSAGE_SIZE];
-    char err_output[MESSAGE_SIZE];
+    gg_arena arena = NULL;
+    void *scratch = NULL;
+    char *input = NULL;
+    char *output = NULL;
+    char *err_output = NULL;
+    const char *context_value = NULL;
+    size_t context_value_size = 0;
     size_t amount_read = 0;
     int ret = 0;
 
-    memset(input, 0, MESSAGE_SIZE);
-    memset(output, 0, MESSAGE_SIZE);
-    memset(err_output, 0, MESSAGE_SIZE);
+    /* Scratch buffers come from the invocation arena, which is released in
+     * one go when the handler returns, so they are never freed here. */
+    err = gg_lambda_context_get_arena(cxt, &arena);
+    if(!err) {
+        err = gg_arena_alloc(arena, 3 * MESSAGE_SIZE, 0, &scratch);
+    }
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to allocate scratch buffers: %d", err);
+        /* Answer the invoker rather than leaving it waiting. */
+        err = gg_lambda_handler_write_error("Failed to allocate memory");
+        if(err) {
+            gg_log(GG_LOG_ERROR, "Failed to send error back: %d", err);
+        }
+        goto cleanup;
+    }
+    input = (char *)scratch;
+    output = input + MESSAGE_SIZE;
+    err_output = output + MESSAGE_SIZE;
+
+    memset(input, 0, 3 * MESSAGE_SIZE);
 
-    gg_log(GG_LOG_INFO, "Client context: %s", cxt->client_context);
+    /* The client context is decoded on first access, no manual base64 or
+     * JSON handling is needed. It is informational here, so an invoker
+     * sending one that is not JSON still gets its response. */
+    err = gg_lambda_context_get_client_context_value(cxt, "custom.value",
+            &context_value, &context_value_size);
+    if(err) {
+        gg_log(GG_LOG_WARN, "Failed to decode client context: %d", err);
+        context_value = NULL;
+    }
+    gg_log(GG_LOG_INFO, "Client context custom.value: %s",
+            context_value ? context_value : "(none)");
 
     /* Read input event for the lambda to process. */
     err = loop_lambda_request_read(input, MESSAGE_SIZE, &amount_read);
     if(err) {
         gg_log(GG_LOG_ERROR,
                 "Failed to read data. amount_read(%zu), amount_requested(%zu), err(%d)" ,
-                amount_read, sizeof(input), err);
+                amount_read, (size_t)MESSAGE_SIZE, err);
 
         goto cleanup;
     }
@@ -9,6 +9,7 @@
 
 #define ERROR_BUFFER_SIZE 128
 #define RESPONSE_SIZE 128
+#define INVOKE_TIMEOUT_MS 5000
 
 /* loop read the request bytes into buffer. */
 gg_error loop_request_read(gg_request ggreq, void *buffer,
@@ -39,8 +40,10 @@ gg_error invoke_a_lambda() {
     /* payload should be a binary payload without null terminator. */
     char payload[] = {'h', 'e', 'l', 'l', 'o'};
     size_t amount_read = 0;
-    /* example context: base64-encoded json { "custom":{ "value": "key" }} */
-    char customer_context[] = "eyAiY3VzdG9tIjp7ICJ2YWx1ZSI6ICJrZXkiIH19";
+    /* example context, sent base64-encoded. */
+    const char context_json[] = "{ \"custom\":{ \"value\": \"key\" }}";
+    char customer_context[GG_BASE64_ENCODED_SIZE(sizeof(context_json) - 1)];
+    size_t customer_context_size = 0;
     char qualifier[] = "1";
     char response[RESPONSE_SIZE];
     char error[ERROR_BUFFER_SIZE];
@@ -59,6 +62,13 @@ gg_error invoke_a_lambda() {
         .payload_size = sizeof(payload)
     };
 
+    err = gg_base64_encode(context_json, sizeof(context_json) - 1,
+            customer_context, sizeof(customer_context), &customer_context_size);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to encode customer context: %d", err);
+        goto done;
+    }
+
     /* Initialize the request handle. */
     err = gg_request_init(&ggreq);
     if(err) {
@@ -66,6 +76,13 @@ gg_error invoke_a_lambda() {
         goto done;
     }
 
+    /* Do not wait forever on a stuck invokee. */
+    err = gg_request_set_timeout(ggreq, INVOKE_TIMEOUT_MS);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to set request timeout: %d", err);
+        goto cleanup;
+    }
+
     err = gg_invoke(ggreq, &opts, &result);
     if(err) {
         gg_log(GG_LOG_ERROR, "gg_invoke failed with client error: %d", err);
@@ -102,6 +119,10 @@ gg_error invoke_a_lambda() {
         gg_log(GG_LOG_INFO, "Lambda invocation failed. error: %s status: %d",
                 error, result.request_status);
         break;
+    case GG_REQUEST_TIMEOUT:
+        gg_log(GG_LOG_ERROR, "Lambda invocation timed out after %d ms",
+                INVOKE_TIMEOUT_MS);
+        break;
     default:
         gg_log(GG_LOG_ERROR, "Some other errors happened: %d", result.request_status);
     }
@@ -8,7 +8,9 @@
  *
  * The example uses gg_publish_with_options instead of gg_publish in order to
  * take advantage of the increased reliability provided by setting
- * GG_QUEUE_FULL_POLICY_ALL_OR_ERROR.
+ * GG_QUEUE_FULL_POLICY_ALL_OR_ERROR. Publishes rejected because the queue is
+ * full are written to a spool in /tmp and delivered in the background, so the
+ * handler neither drops them nor blocks.
  *
  */
 
@@ -18,6 +20,10 @@
 #include "greengrasssdk.h"
 
 #define MESSAGE_SIZE 100
+#define SPOOL_PATH "/tmp/publish_example.spool"
+#define SPOOL_BYTE_BUDGET (4 * 1024 * 1024)
+
+static gg_spool spool = NULL;
 
 void handler(const gg_lambda_context *cxt) {
     gg_error err = GGE_SUCCESS;
@@ -55,6 +61,12 @@ void handler(const gg_lambda_context *cxt) {
         goto cleanup;
     }
 
+    err = gg_publish_options_set_spool(opts, spool);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to set publish options: %d", err);
+        goto cleanup;
+    }
+
     err = gg_publish_with_options(ggreq, topic, message, MESSAGE_SIZE, opts,
         &result);
     if(err) {
@@ -62,7 +74,9 @@ void handler(const gg_lambda_context *cxt) {
         goto cleanup;
     }
 
-    if(result.request_status) {
+    if(result.request_status == GG_REQUEST_SPOOLED) {
+        gg_log(GG_LOG_INFO, "Queue is full, publish was spooled");
+    } else if(result.request_status) {
         gg_log(GG_LOG_ERROR, "gg_publish had result request_status %d",
             result.request_status);
         goto cleanup;
@@ -83,8 +97,17 @@ int main() {
         goto cleanup;
     }
 
+    err = gg_spool_open(&spool, SPOOL_PATH, SPOOL_BYTE_BUDGET,
+        GG_SPOOL_OVERFLOW_DROP_OLDEST);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "gg_spool_open failed %d", err);
+        goto cleanup;
+    }
+
     gg_runtime_start(handler, 0);
 
+    gg_spool_close(spool);
+
 cleanup:
     return -1;
 }
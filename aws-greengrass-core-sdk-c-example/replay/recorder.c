@@ -0,0 +1,111 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * This example records every invocation the lambda receives, with its
+ * function arn, client context, payload and arrival time, into the trace file
+ * named by the TRACE_FILE environment variable. Copy record_invocation into
+ * an existing handler to capture its production traffic for the replayer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "greengrasssdk.h"
+#include "trace.h"
+
+#define DEFAULT_TRACE_FILE "/tmp/invocations.trace"
+#define READ_CHUNK_SIZE 4096
+
+static trace_file trace;
+
+/* read the whole handler event into a heap buffer grown as needed. */
+gg_error read_event(uint8_t **event, size_t *event_size) {
+    gg_error err = GGE_SUCCESS;
+    size_t capacity = 0;
+    size_t amount_read = 0;
+    uint8_t *grown = NULL;
+
+    *event = NULL;
+    *event_size = 0;
+
+    do {
+        if(capacity - *event_size < READ_CHUNK_SIZE) {
+            capacity += READ_CHUNK_SIZE;
+            grown = (uint8_t *)realloc(*event, capacity);
+            if(!grown) {
+                err = GGE_OUT_OF_MEMORY;
+                goto cleanup;
+            }
+            *event = grown;
+        }
+
+        err = gg_lambda_handler_read(*event + *event_size,
+                capacity - *event_size, &amount_read);
+        if(err) {
+            gg_log(GG_LOG_ERROR, "gg_lambda_handler_read had an error");
+            goto cleanup;
+        }
+        *event_size += amount_read;
+    } while(amount_read);
+
+cleanup:
+    if(err) {
+        free(*event);
+        *event = NULL;
+    }
+    return err;
+}
+
+gg_error record_invocation(const gg_lambda_context *cxt, uint64_t arrival_us,
+        const uint8_t *event, size_t event_size) {
+    gg_error err = trace_write(&trace, cxt, arrival_us, event, event_size);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to record invocation: %d", err);
+    }
+    return err;
+}
+
+void handler(const gg_lambda_context *cxt) {
+    gg_error err = GGE_SUCCESS;
+    /* taken before reading, so large payloads do not stretch the gaps. */
+    uint64_t arrival_us = trace_now_us();
+    uint8_t *event = NULL;
+    size_t event_size = 0;
+
+    err = read_event(&event, &event_size);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to read event: %d", err);
+        goto cleanup;
+    }
+
+    record_invocation(cxt, arrival_us, event, event_size);
+
+    /* Process the event here. */
+
+cleanup:
+    free(event);
+}
+
+int main() {
+    gg_error err = GGE_SUCCESS;
+    const char *trace_path = getenv("TRACE_FILE");
+
+    err = gg_global_init(0);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "gg_global_init failed %d", err);
+        goto cleanup;
+    }
+
+    err = trace_open_write(&trace,
+            trace_path ? trace_path : DEFAULT_TRACE_FILE);
+    if(err) {
+        goto cleanup;
+    }
+
+    gg_runtime_start(handler, 0);
+
+    trace_close(&trace);
+
+cleanup:
+    return -1;
+}
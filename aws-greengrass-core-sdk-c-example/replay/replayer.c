@@ -0,0 +1,239 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * This example replays an invocation trace written by the recorder example
+ * against another lambda with gg_invoke and reports the invoke latency. A
+ * replay is started by invoking this lambda, and is configured through
+ * environment variables:
+ *   TRACE_FILE           trace to replay, defaults to /tmp/invocations.trace
+ *   TARGET_FUNCTION_ARN  lambda to invoke, defaults to the recorded arn
+ *   REPLAY_SPEED         "1" for the recorded rate, "N" for N times faster,
+ *                        "max" to invoke back to back
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "greengrasssdk.h"
+#include "trace.h"
+
+#define DEFAULT_TRACE_FILE "/tmp/invocations.trace"
+#define DISCARD_BUFFER_SIZE 4096
+#define SUMMARY_SIZE 256
+
+typedef struct replay_stats {
+    uint64_t *latencies_us;
+    size_t count;
+    size_t capacity;
+    size_t failures;
+    uint64_t max_behind_us;
+} replay_stats;
+
+static void sleep_until_us(uint64_t deadline_us) {
+    uint64_t now_us = trace_now_us();
+    struct timespec delay;
+
+    if(deadline_us <= now_us) {
+        return;
+    }
+    delay.tv_sec = (time_t)((deadline_us - now_us) / 1000000);
+    delay.tv_nsec = (long)((deadline_us - now_us) % 1000000 * 1000);
+    nanosleep(&delay, NULL);
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static uint64_t percentile(const replay_stats *stats, unsigned int pct) {
+    return stats->count
+        ? stats->latencies_us[(stats->count - 1) * pct / 100] : 0;
+}
+
+static gg_error add_latency(replay_stats *stats, uint64_t latency_us) {
+    uint64_t *grown = NULL;
+
+    if(stats->count == stats->capacity) {
+        stats->capacity = stats->capacity ? 2 * stats->capacity : 1024;
+        grown = (uint64_t *)realloc(stats->latencies_us,
+                stats->capacity * sizeof(uint64_t));
+        if(!grown) {
+            return GGE_OUT_OF_MEMORY;
+        }
+        stats->latencies_us = grown;
+    }
+    stats->latencies_us[stats->count++] = latency_us;
+    return GGE_SUCCESS;
+}
+
+/* invoke the target with one recorded event and drain its response. */
+gg_error replay_record(const trace_record *record, const char *target_arn,
+        gg_request_status *status) {
+    gg_error err = GGE_SUCCESS;
+    gg_request ggreq = NULL;
+    gg_request_result result;
+    char discard[DISCARD_BUFFER_SIZE];
+    size_t amount_read = 0;
+    gg_invoke_options opts;
+
+    opts.function_arn = target_arn ? target_arn : record->function_arn;
+    opts.customer_context =
+        record->client_context[0] ? record->client_context : NULL;
+    opts.qualifier = NULL;
+    opts.type = GG_INVOKE_REQUEST_RESPONSE;
+    opts.payload = record->payload;
+    opts.payload_size = record->payload_size;
+
+    err = gg_request_init(&ggreq);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to initialize request");
+        goto done;
+    }
+
+    err = gg_invoke(ggreq, &opts, &result);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "gg_invoke failed with client error: %d", err);
+        goto cleanup;
+    }
+    *status = result.request_status;
+
+    do {
+        err = gg_request_read(ggreq, discard, sizeof(discard), &amount_read);
+        if(err) {
+            gg_log(GG_LOG_ERROR, "gg_request_read had an error");
+            goto cleanup;
+        }
+    } while(amount_read);
+
+cleanup:
+    gg_request_close(ggreq);
+
+done:
+    return err;
+}
+
+gg_error replay(const char *trace_path, const char *target_arn,
+        const char *speed, replay_stats *stats) {
+    gg_error err = GGE_SUCCESS;
+    trace_file trace;
+    trace_record record;
+    int has_record = 0;
+    int max_rate = speed && !strcmp(speed, "max");
+    double rate = speed && !max_rate ? atof(speed) : 1.0;
+    uint64_t scheduled_us = 0;
+    uint64_t start_us = 0;
+    uint64_t now_us = 0;
+    gg_request_status status = GG_REQUEST_SUCCESS;
+
+    if(!max_rate && rate <= 0) {
+        gg_log(GG_LOG_ERROR, "Invalid REPLAY_SPEED: %s", speed);
+        err = GGE_INVALID_PARAMETER;
+        goto done;
+    }
+
+    err = trace_open_read(&trace, trace_path);
+    if(err) {
+        goto done;
+    }
+
+    scheduled_us = trace_now_us();
+    for(;;) {
+        err = trace_read(&trace, &record, &has_record);
+        if(err || !has_record) {
+            break;
+        }
+
+        if(!max_rate) {
+            scheduled_us += (uint64_t)(record.delay_us / rate);
+            sleep_until_us(scheduled_us);
+        }
+
+        start_us = trace_now_us();
+        if(!max_rate && start_us > scheduled_us
+                && start_us - scheduled_us > stats->max_behind_us) {
+            stats->max_behind_us = start_us - scheduled_us;
+        }
+
+        err = replay_record(&record, target_arn, &status);
+        now_us = trace_now_us();
+        trace_record_free(&record);
+        if(err || status != GG_REQUEST_SUCCESS) {
+            stats->failures++;
+            err = GGE_SUCCESS;
+            continue;
+        }
+
+        err = add_latency(stats, now_us - start_us);
+        if(err) {
+            break;
+        }
+    }
+
+    trace_close(&trace);
+
+done:
+    return err;
+}
+
+void handler(const gg_lambda_context *cxt) {
+    gg_error err = GGE_SUCCESS;
+    const char *trace_path = getenv("TRACE_FILE");
+    replay_stats stats;
+    char summary[SUMMARY_SIZE];
+    int ret = 0;
+
+    (void)cxt;
+    memset(&stats, 0, sizeof(stats));
+
+    err = replay(trace_path ? trace_path : DEFAULT_TRACE_FILE,
+            getenv("TARGET_FUNCTION_ARN"), getenv("REPLAY_SPEED"), &stats);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Replay failed: %d", err);
+        gg_lambda_handler_write_error("Replay failed");
+        goto cleanup;
+    }
+
+    qsort(stats.latencies_us, stats.count, sizeof(uint64_t), compare_u64);
+    ret = snprintf(summary, sizeof(summary),
+            "invocations: %zu failures: %zu latency us p50: %llu p90: %llu "
+            "p99: %llu max: %llu max behind schedule us: %llu",
+            stats.count, stats.failures,
+            (unsigned long long)percentile(&stats, 50),
+            (unsigned long long)percentile(&stats, 90),
+            (unsigned long long)percentile(&stats, 99),
+            (unsigned long long)percentile(&stats, 100),
+            (unsigned long long)stats.max_behind_us);
+    if(ret < 0 || ret >= SUMMARY_SIZE) {
+        gg_log(GG_LOG_ERROR, "Failed to format summary. return code: %d", ret);
+        goto cleanup;
+    }
+
+    gg_log(GG_LOG_INFO, "Replay done, %s", summary);
+    err = gg_lambda_handler_write_response(summary, ret);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to send reponse: %d", err);
+    }
+
+cleanup:
+    free(stats.latencies_us);
+}
+
+int main() {
+    gg_error err = GGE_SUCCESS;
+
+    err = gg_global_init(0);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "gg_global_init failed %d", err);
+        goto cleanup;
+    }
+
+    gg_runtime_start(handler, 0);
+
+cleanup:
+    return -1;
+}
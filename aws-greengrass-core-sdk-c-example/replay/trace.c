@@ -0,0 +1,212 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "trace.h"
+
+#define TRACE_MAGIC "GGTRACE1"
+#define TRACE_MAGIC_SIZE 8
+#define TRACE_RECORD_HEADER_SIZE 20
+#define TRACE_FIELD_SIZE_MAX UINT32_MAX
+
+uint64_t trace_now_us(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+static void put_le(uint8_t *dst, uint64_t value, size_t size) {
+    size_t i;
+
+    for(i = 0; i < size; i++) {
+        dst[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint64_t get_le(const uint8_t *src, size_t size) {
+    uint64_t value = 0;
+    size_t i;
+
+    for(i = 0; i < size; i++) {
+        value |= (uint64_t)src[i] << (8 * i);
+    }
+    return value;
+}
+
+gg_error trace_open_write(trace_file *trace, const char *path) {
+    gg_error err = GGE_SUCCESS;
+
+    trace->last_record_us = 0;
+    trace->file = fopen(path, "ab");
+    if(!trace->file) {
+        gg_log(GG_LOG_ERROR, "Failed to open trace %s for writing", path);
+        err = GGE_INVALID_PARAMETER;
+        goto done;
+    }
+
+    /* A new trace starts with the magic. */
+    if(ftell(trace->file) == 0
+            && fwrite(TRACE_MAGIC, TRACE_MAGIC_SIZE, 1, trace->file) != 1) {
+        gg_log(GG_LOG_ERROR, "Failed to write trace header to %s", path);
+        err = GGE_INTERNAL_FAILURE;
+        trace_close(trace);
+        goto done;
+    }
+
+done:
+    return err;
+}
+
+gg_error trace_open_read(trace_file *trace, const char *path) {
+    gg_error err = GGE_SUCCESS;
+    char magic[TRACE_MAGIC_SIZE];
+
+    trace->last_record_us = 0;
+    trace->file = fopen(path, "rb");
+    if(!trace->file) {
+        gg_log(GG_LOG_ERROR, "Failed to open trace %s for reading", path);
+        err = GGE_INVALID_PARAMETER;
+        goto done;
+    }
+
+    if(fread(magic, TRACE_MAGIC_SIZE, 1, trace->file) != 1
+            || memcmp(magic, TRACE_MAGIC, TRACE_MAGIC_SIZE)) {
+        gg_log(GG_LOG_ERROR, "%s is not an invocation trace", path);
+        err = GGE_INVALID_PARAMETER;
+        trace_close(trace);
+        goto done;
+    }
+
+done:
+    return err;
+}
+
+gg_error trace_write(trace_file *trace, const gg_lambda_context *cxt,
+                     uint64_t arrival_us, const void *payload,
+                     size_t payload_size) {
+    gg_error err = GGE_SUCCESS;
+    uint8_t header[TRACE_RECORD_HEADER_SIZE];
+    const char *function_arn = cxt->function_arn ? cxt->function_arn : "";
+    const char *client_context = cxt->client_context ? cxt->client_context : "";
+    size_t function_arn_size = strlen(function_arn);
+    size_t client_context_size = strlen(client_context);
+
+    /* Sizes are stored in 32 bits, truncating one would corrupt every later
+     * record. */
+    if(function_arn_size > TRACE_FIELD_SIZE_MAX
+            || client_context_size > TRACE_FIELD_SIZE_MAX
+            || payload_size > TRACE_FIELD_SIZE_MAX) {
+        gg_log(GG_LOG_ERROR, "Invocation is too large to be recorded");
+        err = GGE_INVALID_PARAMETER;
+        goto done;
+    }
+
+    put_le(header, trace->last_record_us && arrival_us > trace->last_record_us
+            ? arrival_us - trace->last_record_us : 0, 8);
+    put_le(header + 8, function_arn_size, 4);
+    put_le(header + 12, client_context_size, 4);
+    put_le(header + 16, payload_size, 4);
+    trace->last_record_us = arrival_us;
+
+    if(fwrite(header, sizeof(header), 1, trace->file) != 1
+            || fwrite(function_arn, 1, function_arn_size, trace->file)
+                != function_arn_size
+            || fwrite(client_context, 1, client_context_size, trace->file)
+                != client_context_size
+            || fwrite(payload, 1, payload_size, trace->file) != payload_size
+            || fflush(trace->file)) {
+        gg_log(GG_LOG_ERROR, "Failed to write trace record");
+        err = GGE_INTERNAL_FAILURE;
+    }
+
+done:
+    return err;
+}
+
+/* Read size bytes into a new buffer with one extra null terminator. */
+static gg_error read_field(FILE *file, size_t size, char **field) {
+    gg_error err = GGE_SUCCESS;
+
+    *field = (char *)malloc(size + 1);
+    if(!*field) {
+        err = GGE_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    if(fread(*field, 1, size, file) != size) {
+        gg_log(GG_LOG_ERROR, "Trace record is truncated");
+        err = GGE_INTERNAL_FAILURE;
+        goto done;
+    }
+    (*field)[size] = '\0';
+
+done:
+    return err;
+}
+
+gg_error trace_read(trace_file *trace, trace_record *record, int *has_record) {
+    gg_error err = GGE_SUCCESS;
+    uint8_t header[TRACE_RECORD_HEADER_SIZE];
+    char *payload = NULL;
+
+    memset(record, 0, sizeof(*record));
+    *has_record = 0;
+
+    if(fread(header, sizeof(header), 1, trace->file) != 1) {
+        if(ferror(trace->file)) {
+            gg_log(GG_LOG_ERROR, "Failed to read trace record");
+            err = GGE_INTERNAL_FAILURE;
+        }
+        goto done;
+    }
+
+    record->delay_us = get_le(header, 8);
+    record->payload_size = (size_t)get_le(header + 16, 4);
+
+    err = read_field(trace->file, (size_t)get_le(header + 8, 4),
+            &record->function_arn);
+    if(err) {
+        goto cleanup;
+    }
+    err = read_field(trace->file, (size_t)get_le(header + 12, 4),
+            &record->client_context);
+    if(err) {
+        goto cleanup;
+    }
+    err = read_field(trace->file, record->payload_size, &payload);
+    record->payload = payload;
+    if(err) {
+        goto cleanup;
+    }
+
+    *has_record = 1;
+
+cleanup:
+    if(err) {
+        trace_record_free(record);
+    }
+
+done:
+    return err;
+}
+
+void trace_record_free(trace_record *record) {
+    free(record->function_arn);
+    free(record->client_context);
+    free(record->payload);
+    memset(record, 0, sizeof(*record));
+}
+
+void trace_close(trace_file *trace) {
+    if(trace->file) {
+        fclose(trace->file);
+        trace->file = NULL;
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Compact invocation trace file shared by the recorder and replayer examples.
+ *
+ * A trace starts with the 8 byte magic "GGTRACE1" followed by one record per
+ * invocation:
+ *   uint64_t delay_us          time since the previous record, 0 for the first
+ *   uint32_t function_arn_size
+ *   uint32_t client_context_size
+ *   uint32_t payload_size
+ *   function_arn, client_context and payload bytes, not null-terminated
+ * Integers are stored in little endian byte order.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include "greengrasssdk.h"
+
+typedef struct trace_file {
+    FILE *file;
+    /* monotonic time of the last written record in microseconds */
+    uint64_t last_record_us;
+} trace_file;
+
+/* One invocation read back from a trace, fields are heap allocated. */
+typedef struct trace_record {
+    uint64_t delay_us;
+    char *function_arn;
+    char *client_context;
+    void *payload;
+    size_t payload_size;
+} trace_record;
+
+/* Open a trace for appending records, creating it when missing. */
+gg_error trace_open_write(trace_file *trace, const char *path);
+
+/* Open an existing trace for reading records from the start. */
+gg_error trace_open_read(trace_file *trace, const char *path);
+
+/*
+ * Append the invocation described by cxt and payload to the trace.
+ * arrival_us is the trace_now_us() time the handler was entered, taken
+ * before reading the payload so the recorded gap excludes the read time.
+ */
+gg_error trace_write(trace_file *trace, const gg_lambda_context *cxt,
+                     uint64_t arrival_us, const void *payload,
+                     size_t payload_size);
+
+/*
+ * Read the next record. has_record is set to 0 at the end of the trace.
+ * Records must be released with trace_record_free.
+ */
+gg_error trace_read(trace_file *trace, trace_record *record, int *has_record);
+
+void trace_record_free(trace_record *record);
+
+void trace_close(trace_file *trace);
+
+/* Current monotonic time in microseconds. */
+uint64_t trace_now_us(void);
+
+#endif
@@ -2,7 +2,8 @@
  * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
  *
  * This example shows how to update Greengrass local shadow and get the 
- * shadow document back.
+ * shadow document back. Updates with an unchanged desired state are
+ * suppressed by the SDK, except for one heartbeat update per minute.
  */
 
 #include <stdio.h>
@@ -10,6 +11,11 @@
 #include "greengrasssdk.h"
 
 #define BUFFER_SIZE 512
+#define MAX_JSON_TOKEN_SIZE 256
+#define SHADOW_HEARTBEAT_MS (60 * 1000)
+
+/* created once so that its dedup state lasts across invocations. */
+static gg_publish_options update_opts = NULL;
 
 /* loop read the request bytes into buffer. */
 gg_error loop_request_read(gg_request ggreq, void *buffer,
@@ -57,7 +63,8 @@ gg_error update_thing_shadow() {
         goto done;
     }
 
-    err = gg_update_thing_shadow(ggreq, thing_name, payload, &result);
+    err = gg_update_thing_shadow_with_options(ggreq, thing_name, payload,
+            update_opts, &result);
     if(err) {
         gg_log(GG_LOG_ERROR, "gg_update_thing_shadow failed with err %d",
             err);
@@ -66,7 +73,10 @@ gg_error update_thing_shadow() {
 
     gg_log(GG_LOG_INFO, "gg_update_thing_shadow had result request_status %d",
             result.request_status);
-    if(result.request_status != GG_REQUEST_SUCCESS) {
+    if(result.request_status == GG_REQUEST_SUPPRESSED) {
+        // desired state is unchanged, nothing was sent
+        gg_log(GG_LOG_INFO, "update_thing_shadow skipped, shadow unchanged");
+    } else if(result.request_status != GG_REQUEST_SUCCESS) {
         // shadow update failed, reads error response
         err = loop_request_read(ggreq, read_buf, BUFFER_SIZE, &amount_read);
         if(err) {
@@ -101,6 +111,8 @@ done:
 gg_error get_thing_shadow() {
     gg_error err = GGE_SUCCESS;
     gg_request ggreq = NULL;
+    gg_json_reader reader = NULL;
+    gg_json_token token;
     const char thing_name[] = "foo";
     size_t amount_read = 0;
     struct gg_request_result result;
@@ -133,19 +145,33 @@ gg_error get_thing_shadow() {
         gg_log(GG_LOG_ERROR, "get_thing_shadow failed. error message: %.*s",
                 (int)amount_read, read_buf);
     } else {
-        // get shadow succeeded, reads success response
-        err = loop_request_read(ggreq, read_buf, BUFFER_SIZE, &amount_read);
+        // get shadow succeeded, streams the document for the desired mode
+        // so that documents of any size can be read
+        err = gg_json_reader_init(&reader, MAX_JSON_TOKEN_SIZE);
         if(err) {
-            gg_log(GG_LOG_ERROR,
-                    "Failed to read shadow data. amount_read(%zu), READ_BUFFER_SIZE(%zu), err(%d)",
-                    amount_read, BUFFER_SIZE, err);
+            gg_log(GG_LOG_ERROR, "Failed to initialize json reader");
             goto cleanup;
         }
 
-        gg_log(GG_LOG_INFO, "get_thing_shadow succeeded. response: %.*s",
-                (int)amount_read, read_buf);
+        err = gg_json_reader_find_in_request(reader, ggreq,
+                "state.desired.mode", &token);
+        if(err) {
+            gg_log(GG_LOG_ERROR, "Failed to read shadow data. err(%d)", err);
+            goto cleanup;
+        }
+
+        if(token.type == GG_JSON_TOKEN_STRING) {
+            gg_log(GG_LOG_INFO, "get_thing_shadow succeeded. desired mode: %.*s",
+                    (int)token.data_size, token.data);
+        } else {
+            gg_log(GG_LOG_INFO,
+                    "get_thing_shadow succeeded. no desired mode in shadow");
+        }
     }
 cleanup:
+    if(reader) {
+        gg_json_reader_free(reader);
+    }
     gg_request_close(ggreq);
 
 done:
@@ -170,9 +196,23 @@ int main() {
         goto cleanup;
     }
 
+    err = gg_publish_options_init(&update_opts);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to initialize publish options: %d", err);
+        goto cleanup;
+    }
+
+    err = gg_publish_options_set_dedup(update_opts, SHADOW_HEARTBEAT_MS);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to set publish options: %d", err);
+        goto cleanup;
+    }
+
     /* start the runtime in blocking mode. This blocks forever. */
     gg_runtime_start(handler, 0);
 
+    gg_publish_options_free(update_opts);
+
 cleanup:
     return -1;
 }
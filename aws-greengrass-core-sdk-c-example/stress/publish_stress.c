@@ -0,0 +1,250 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * This example stresses the SDK from many threads at once and reports how
+ * publish throughput scales with the thread count. Each invocation runs
+ * rounds of 1, 2, 4, ... up to STRESS_MAX_THREADS threads (default: the
+ * number of online cpus) for STRESS_DURATION_MS milliseconds each (default
+ * 2000). Every thread publishes to STRESS_TOPIC (default "stress/publish")
+ * with its own requests, a publish options shared by all threads and a rate
+ * limited log call site shared by all threads.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "greengrasssdk.h"
+
+#define DEFAULT_TOPIC "stress/publish"
+#define DEFAULT_DURATION_MS 2000
+#define PAYLOAD_SIZE 64
+#define SUMMARY_SIZE 1024
+
+typedef struct stress_config {
+    const char *topic;
+    gg_publish_options opts;
+    uint64_t end_ms;
+} stress_config;
+
+typedef struct stress_worker {
+    pthread_t thread;
+    const stress_config *config;
+    unsigned int id;
+    uint64_t published;
+    uint64_t throttled;
+    uint64_t failed;
+} stress_worker;
+
+/* one rate limited log call site shared by every thread. */
+static gg_log_ratelimit failure_log = GG_LOG_RATELIMIT_INIT(1, 1000, 1);
+
+static uint64_t now_ms(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+static unsigned int env_uint(const char *name, unsigned int fallback) {
+    const char *value = getenv(name);
+    return value && atoi(value) > 0 ? (unsigned int)atoi(value) : fallback;
+}
+
+static void *stress_thread(void *arg) {
+    stress_worker *worker = (stress_worker *)arg;
+    gg_error err = GGE_SUCCESS;
+    gg_request ggreq = NULL;
+    gg_request_result result;
+    char payload[PAYLOAD_SIZE];
+    int payload_size = 0;
+
+    while(now_ms() < worker->config->end_ms) {
+        payload_size = snprintf(payload, sizeof(payload),
+                "{\"thread\": %u, \"seq\": %llu}", worker->id,
+                (unsigned long long)worker->published);
+
+        err = gg_request_init(&ggreq);
+        if(err) {
+            /* Failing again right away would only spin until the deadline. */
+            worker->failed++;
+            gg_log_ratelimited(&failure_log, GG_LOG_WARN,
+                    "gg_request_init failed: %d", err);
+            break;
+        }
+
+        err = gg_publish_with_options(ggreq, worker->config->topic, payload,
+                (size_t)payload_size, worker->config->opts, &result);
+        if(err) {
+            worker->failed++;
+            gg_log_ratelimited(&failure_log, GG_LOG_WARN,
+                    "gg_publish_with_options failed: %d", err);
+        } else if(result.request_status == GG_REQUEST_AGAIN) {
+            worker->throttled++;
+        } else if(result.request_status != GG_REQUEST_SUCCESS) {
+            worker->failed++;
+        } else {
+            worker->published++;
+        }
+
+        gg_request_close(ggreq);
+    }
+
+    return NULL;
+}
+
+/* run one round with thread_count threads and return publishes per second. */
+gg_error run_round(stress_config *config, unsigned int thread_count,
+        unsigned int duration_ms, double *rate) {
+    gg_error err = GGE_SUCCESS;
+    stress_worker *workers = NULL;
+    unsigned int started = 0;
+    unsigned int i = 0;
+    uint64_t published = 0;
+    uint64_t throttled = 0;
+    uint64_t failed = 0;
+
+    workers = (stress_worker *)calloc(thread_count, sizeof(stress_worker));
+    if(!workers) {
+        err = GGE_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    config->end_ms = now_ms() + duration_ms;
+    for(started = 0; started < thread_count; started++) {
+        workers[started].config = config;
+        workers[started].id = started;
+        if(pthread_create(&workers[started].thread, NULL, stress_thread,
+                &workers[started])) {
+            gg_log(GG_LOG_ERROR, "Failed to start thread %u", started);
+            err = GGE_INTERNAL_FAILURE;
+            break;
+        }
+    }
+
+    for(i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        published += workers[i].published;
+        throttled += workers[i].throttled;
+        failed += workers[i].failed;
+    }
+
+    *rate = published * 1000.0 / duration_ms;
+    gg_log(GG_LOG_INFO,
+            "threads: %u published: %llu throttled: %llu failed: %llu "
+            "rate: %.0f/s", thread_count, (unsigned long long)published,
+            (unsigned long long)throttled, (unsigned long long)failed, *rate);
+
+    free(workers);
+
+done:
+    return err;
+}
+
+void handler(const gg_lambda_context *cxt) {
+    gg_error err = GGE_SUCCESS;
+    stress_config config;
+    const char *topic = getenv("STRESS_TOPIC");
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int max_threads = env_uint("STRESS_MAX_THREADS",
+            cpus > 0 ? (unsigned int)cpus : 1);
+    unsigned int duration_ms = env_uint("STRESS_DURATION_MS",
+            DEFAULT_DURATION_MS);
+    unsigned int threads = 0;
+    double rate = 0;
+    double single_rate = 0;
+    char summary[SUMMARY_SIZE];
+    size_t summary_size = 0;
+    int ret = 0;
+
+    (void)cxt;
+    memset(&config, 0, sizeof(config));
+    config.topic = topic ? topic : DEFAULT_TOPIC;
+
+    err = gg_publish_options_init(&config.opts);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to initialize publish options: %d", err);
+        goto fail;
+    }
+
+    err = gg_publish_options_set_queue_full_policy(config.opts,
+            GG_QUEUE_FULL_POLICY_ALL_OR_ERROR);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to set publish options: %d", err);
+        goto fail;
+    }
+
+    for(threads = 1; threads <= max_threads; threads *= 2) {
+        err = run_round(&config, threads, duration_ms, &rate);
+        if(err) {
+            gg_log(GG_LOG_ERROR, "Stress round with %u threads failed: %d",
+                    threads, err);
+            goto fail;
+        }
+        if(threads == 1) {
+            single_rate = rate;
+        }
+
+        /* Scaling is the speedup over one thread divided by the thread
+         * count, 1.00 being perfectly linear. */
+        ret = snprintf(summary + summary_size, SUMMARY_SIZE - summary_size,
+                "%u threads: %.0f/s scaling %.2f\n", threads, rate,
+                single_rate > 0 ? rate / single_rate / threads : 0.0);
+        if(ret < 0 || (size_t)ret >= SUMMARY_SIZE - summary_size) {
+            break;
+        }
+        summary_size += (size_t)ret;
+    }
+
+    err = gg_lambda_handler_write_response(summary, summary_size);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to send reponse: %d", err);
+    }
+    goto cleanup;
+
+fail:
+    err = gg_lambda_handler_write_error("Stress test failed");
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to send error back: %d", err);
+    }
+
+cleanup:
+    gg_publish_options_free(config.opts);
+}
+
+int main() {
+    gg_error err = GGE_SUCCESS;
+    uint32_t opt = 0;
+
+    /* Libraries that do not accept the flag may fail the call, measure with
+     * the default transport then. */
+    err = gg_global_init(GG_GLOBAL_OPT_MULTIPLEXED_CONNECTION);
+    if(err) {
+        gg_log(GG_LOG_WARN, "gg_global_init with multiplexed connection "
+                "failed %d, retrying with default options", err);
+        err = gg_global_init(0);
+    }
+    if(err) {
+        gg_log(GG_LOG_ERROR, "gg_global_init failed %d", err);
+        goto cleanup;
+    }
+
+    /* The scaling numbers depend on the transport in effect. */
+    err = gg_global_get_opt(&opt);
+    if(err) {
+        gg_log(GG_LOG_WARN, "gg_global_get_opt failed %d", err);
+    } else {
+        gg_log(GG_LOG_INFO, "global options in effect: 0x%x, multiplexed "
+                "connection: %s", (unsigned int)opt,
+                (opt & GG_GLOBAL_OPT_MULTIPLEXED_CONNECTION) ? "yes" : "no");
+    }
+
+    gg_runtime_start(handler, 0);
+
+cleanup:
+    return -1;
+}
@@ -1,5 +1,10 @@
 /*
  * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * The AWS SDK and the DynamoDB client are expensive to set up, so they are
+ * created once by the runtime init callback, reached from every invocation
+ * through the runtime user data and torn down by the shutdown callback on
+ * SIGTERM.
  */
 
 #include <stdio.h>
@@ -7,14 +12,35 @@
 #include "greengrasssdk.h"
 #include "tes.h"
 
+gg_error on_init(void *user_data) {
+    if(tesInit((TesClient *)user_data)) {
+        gg_log(GG_LOG_ERROR, "Failed to initialize the DynamoDB client");
+        return GGE_INTERNAL_FAILURE;
+    }
+    return GGE_SUCCESS;
+}
+
+void on_shutdown(void *user_data) {
+    tesShutdown((TesClient *)user_data);
+}
+
 void handler(const gg_lambda_context *cxt) {
-    (void) cxt;
+    gg_error err = GGE_SUCCESS;
+    void *client = NULL;
 
-    listTables();    
+    err = gg_lambda_context_get_user_data(cxt, &client);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to get the DynamoDB client: %d", err);
+        return;
+    }
+
+    listTables((TesClient *)client);
 }
 
 int main() {
     gg_error err = GGE_SUCCESS;
+    gg_runtime_options opts = NULL;
+    TesClient *client = NULL;
 
     err = gg_global_init(0);
     if(err) {
@@ -22,8 +48,36 @@ int main() {
         goto cleanup;
     }
 
-    gg_runtime_start(handler, 0);
+    client = tesCreate();
+    if(!client) {
+        gg_log(GG_LOG_ERROR, "Failed to allocate the DynamoDB client");
+        goto cleanup;
+    }
+
+    err = gg_runtime_options_init(&opts);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to initialize runtime options: %d", err);
+        goto cleanup;
+    }
+
+    err = gg_runtime_options_set_user_data(opts, client);
+    if(!err) {
+        err = gg_runtime_options_set_init_callback(opts, on_init);
+    }
+    if(!err) {
+        err = gg_runtime_options_set_shutdown_callback(opts, on_shutdown);
+    }
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to set runtime options: %d", err);
+        goto cleanup;
+    }
+
+    gg_runtime_start_with_options(handler, 0, opts);
 
 cleanup:
+    gg_runtime_options_free(opts);
+    /* Also reached when the init callback failed, in which case the shutdown
+     * callback did not run. */
+    tesDestroy(client);
     return -1;
 }
@@ -8,36 +8,89 @@
 #include <aws/dynamodb/DynamoDBClient.h>
 #include <aws/dynamodb/model/ListTablesRequest.h>
 #include <aws/dynamodb/model/ListTablesResult.h>
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <new>
 #include "tes.h"
+#include "tes_credentials_provider.h"
 
-void listTables()
+struct TesClient
 {
     Aws::SDKOptions options;
-    Aws::InitAPI(options);
+    std::unique_ptr<Aws::DynamoDB::DynamoDBClient> dynamoClient;
+    bool apiInitialized = false;
+};
+
+TesClient *tesCreate()
+{
+    return new (std::nothrow) TesClient();
+}
+
+int tesInit(TesClient *client)
+{
+    // Called from a C runtime thread, so no exception may escape.
+    try
     {
+        Aws::InitAPI(client->options);
+        client->apiInitialized = true;
+
         Aws::Client::ClientConfiguration config;
         config.region = Aws::String("us-west-2");
 
-        Aws::DynamoDB::DynamoDBClient dynamoClient(config);
+        client->dynamoClient.reset(new Aws::DynamoDB::DynamoDBClient(
+            std::make_shared<TesCredentialsProvider>(), config));
+    }
+    catch(const std::exception& e)
+    {
+        std::cout << "Error: " << e.what() << std::endl;
+        tesShutdown(client);
+        return 1;
+    }
+    catch(...)
+    {
+        std::cout << "Error: unknown exception" << std::endl;
+        tesShutdown(client);
+        return 1;
+    }
+    return 0;
+}
 
-        Aws::DynamoDB::Model::ListTablesRequest ltr;
-        ltr.SetLimit(5);
+void listTables(TesClient *client)
+{
+    Aws::DynamoDB::Model::ListTablesRequest ltr;
+    ltr.SetLimit(5);
 
-        const Aws::DynamoDB::Model::ListTablesOutcome& lto = dynamoClient.ListTables(ltr);
-        if(!lto.IsSuccess())
-        {
-            std::cout << "Error: " << lto.GetError().GetMessage() << std::endl;
-        }
-        else
+    const Aws::DynamoDB::Model::ListTablesOutcome& lto = client->dynamoClient->ListTables(ltr);
+    if(!lto.IsSuccess())
+    {
+        std::cout << "Error: " << lto.GetError().GetMessage() << std::endl;
+    }
+    else
+    {
+        std::cout << "Tables: " << std::endl;
+        for(const auto& s : lto.GetResult().GetTableNames())
         {
-            std::cout << "Tables: " << std::endl;
-            for(const auto& s : lto.GetResult().GetTableNames())
-            {
-                std::cout << s << std::endl;
-            }
+            std::cout << s << std::endl;
         }
     }
+}
 
-    Aws::ShutdownAPI(options);
+void tesShutdown(TesClient *client)
+{
+    client->dynamoClient.reset();
+    if(client->apiInitialized)
+    {
+        Aws::ShutdownAPI(client->options);
+        client->apiInitialized = false;
+    }
+}
+
+void tesDestroy(TesClient *client)
+{
+    if(client)
+    {
+        tesShutdown(client);
+        delete client;
+    }
 }
@@ -9,10 +9,37 @@
 extern "C" {
 #endif
 
+    /**
+     * AWS SDK state and DynamoDB client shared by all invocations.
+     */
+    typedef struct TesClient TesClient;
+
+    /**
+     * Allocate a client, NULL when out of memory.
+     */
+    TesClient *tesCreate();
+
+    /**
+     * Initialize the AWS SDK and create the DynamoDB client. Call once per
+     * process. Returns 0 on success.
+     */
+    int tesInit(TesClient *client);
+
     /**
      * Print Dynamodb Table names.
      */
-    void listTables();
+    void listTables(TesClient *client);
+
+    /**
+     * Destroy the DynamoDB client and shut down the AWS SDK. Does nothing
+     * when client is not initialized.
+     */
+    void tesShutdown(TesClient *client);
+
+    /**
+     * Shut down client if still initialized and free it. client may be NULL.
+     */
+    void tesDestroy(TesClient *client);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ */
+
+#ifndef TES_CREDENTIALS_PROVIDER_H
+#define TES_CREDENTIALS_PROVIDER_H
+
+#include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/core/utils/DateTime.h>
+#include "greengrasssdk.h"
+
+/**
+ * AWS SDK for C++ credentials provider backed by the Greengrass SDK's Token
+ * Exchange Service credential cache. Fetching and refreshing happen in the
+ * Greengrass SDK, so resolving credentials never blocks an AWS call on I/O.
+ */
+class TesCredentialsProvider : public Aws::Auth::AWSCredentialsProvider
+{
+public:
+    Aws::Auth::AWSCredentials GetAWSCredentials() override
+    {
+        const gg_tes_credentials *credentials = nullptr;
+
+        gg_error err = gg_tes_credentials_acquire(&credentials);
+        if(err)
+        {
+            gg_log(GG_LOG_ERROR, "gg_tes_credentials_acquire failed %d", err);
+            return Aws::Auth::AWSCredentials();
+        }
+
+        Aws::Auth::AWSCredentials result(
+            credentials->access_key_id,
+            credentials->secret_access_key,
+            credentials->session_token,
+            Aws::Utils::DateTime(credentials->expiration * 1000));
+
+        gg_tes_credentials_release(credentials);
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * This example shows how to register handlers per MQTT topic filter instead
+ * of dispatching on the topic inside a single handler. It requires
+ * subscriptions to the lambda on "sensors/+/temperature" and "commands/#".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "greengrasssdk.h"
+
+void temperature_handler(const gg_lambda_context *cxt) {
+    const char *topic = NULL;
+    const char *const *wildcards = NULL;
+    gg_error err = GGE_SUCCESS;
+
+    err = gg_lambda_context_get_topic(cxt, &topic, &wildcards, NULL);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to get topic: %d", err);
+        return;
+    }
+
+    /* wildcards[0] is the level matched by '+'. */
+    gg_log(GG_LOG_INFO, "temperature reading from sensor [%s]", wildcards[0]);
+}
+
+void command_handler(const gg_lambda_context *cxt) {
+    const char *topic = NULL;
+    const char *const *wildcards = NULL;
+    gg_error err = GGE_SUCCESS;
+
+    err = gg_lambda_context_get_topic(cxt, &topic, &wildcards, NULL);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to get topic: %d", err);
+        return;
+    }
+
+    /* wildcards[0] holds every level matched by '#'. */
+    gg_log(GG_LOG_INFO, "command [%s] on topic [%s]", wildcards[0], topic);
+}
+
+void default_handler(const gg_lambda_context *cxt) {
+    const char *topic = NULL;
+
+    gg_lambda_context_get_topic(cxt, &topic, NULL, NULL);
+    gg_log(GG_LOG_WARN, "unrouted invocation on topic [%s]",
+            topic ? topic : "(direct invoke)");
+}
+
+int main() {
+    gg_error err = GGE_SUCCESS;
+    gg_runtime_options opts = NULL;
+
+    err = gg_global_init(0);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "gg_global_init failed %d", err);
+        goto cleanup;
+    }
+
+    err = gg_runtime_options_init(&opts);
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to initialize runtime options: %d", err);
+        goto cleanup;
+    }
+
+    err = gg_runtime_options_add_topic_handler(opts, "sensors/+/temperature",
+            temperature_handler);
+    if(!err) {
+        err = gg_runtime_options_add_topic_handler(opts, "commands/#",
+                command_handler);
+    }
+    if(err) {
+        gg_log(GG_LOG_ERROR, "Failed to add topic handler: %d", err);
+        goto cleanup;
+    }
+
+    gg_runtime_start_with_options(default_handler, 0, opts);
+
+cleanup:
+    gg_runtime_options_free(opts);
+    return -1;
+}
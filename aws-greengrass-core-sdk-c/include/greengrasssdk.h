@@ -3,6 +3,12 @@
 /**
  * @file greengrasssdk.h
  * @brief Definition of SDK interfaces.
+ *
+ * Once gg_global_init has returned, every function may be called
+ * concurrently from any thread unless its documentation notes otherwise.
+ * A gg_request must only be used by one thread at a time, while different
+ * requests may be used concurrently. None of the functions serialize on a
+ * process wide lock.
  */
 #ifndef _GREENGRASS_SDK_H_
 #define _GREENGRASS_SDK_H_
@@ -61,6 +67,16 @@ typedef enum gg_request_status {
     GG_REQUEST_UNKNOWN,
     /** function call is throttled, try again */
     GG_REQUEST_AGAIN,
+    /** function call did not complete before the request timeout */
+    GG_REQUEST_TIMEOUT,
+    /** function call was cancelled with gg_request_cancel */
+    GG_REQUEST_CANCELLED,
+    /** publish was rejected by a full queue and written to the publish
+     * options' spool, it will be delivered later */
+    GG_REQUEST_SPOOLED,
+    /** publish or shadow update was not sent because its payload is
+     * unchanged since the last one sent, see gg_publish_options_set_dedup */
+    GG_REQUEST_SUPPRESSED,
 
     GG_REQUEST_RESERVED_MAX,
     GG_REQUEST_RESERVED_PAD = 0x7FFFFFFF
@@ -75,10 +91,17 @@ typedef struct gg_request_result {
     gg_request_status request_status;
 } gg_request_result;
 
+typedef struct _gg_arena *gg_arena;
+
 /**
  * @brief Describes context when lambda handler is called
  * @param function_arn Null-terminated string full lambda ARN
  * @param client_context Null-terminated string of client context
+ * @note The context is allocated by the SDK and must not grow, as a handler
+ *       built against a larger struct would read past its end on an older
+ *       library. Values added later are read with the
+ *       gg_lambda_context_get_xxx() methods, whose versioned symbols keep
+ *       such a handler from loading on a library without them.
  */
 typedef struct gg_lambda_context {
     const char *function_arn;
@@ -98,6 +121,46 @@ typedef enum gg_invoke_type {
     GG_INVOKE_RESERVED_PAD = 0x7FFFFFFF
 } gg_invoke_type;
 
+/**
+ * @brief Smallest payload size passed through shared memory when
+ *        GG_GLOBAL_OPT_SHARED_MEMORY is in effect
+ */
+#define GG_SHARED_MEMORY_PAYLOAD_THRESHOLD (64 * 1024)
+
+/**
+ * @brief Flags set for the gg_global_init(opt)
+ *
+ * Transport flags are requests: with a 1.3 or later library, features the
+ * kernel or Greengrass Core does not support fall back to the default
+ * transport. Use **gg_global_get_opt()** to find out which flags are in
+ * effect.
+ *
+ * gg_global_init is a 1.0 symbol, so passing flags does not keep a binary
+ * from loading against an older library. Those libraries reserve opt and
+ * require it to be 0, so they may fail the call instead of ignoring the
+ * flags. Callers that must also run on them should retry with 0.
+ */
+typedef enum gg_global_opt {
+    /** Use io_uring for the IPC with Greengrass Core, batching submissions and
+     * completions and registering payload buffers. Requires Linux 5.6+ */
+    GG_GLOBAL_OPT_IO_URING = 0x1,
+    /** Pass invoke, publish and handler event payloads of
+     * GG_SHARED_MEMORY_PAYLOAD_THRESHOLD bytes or more in a sealed memfd
+     * instead of streaming them through the socket. The receiver maps them
+     * read-only, see **gg_lambda_handler_read_mapped()** */
+    GG_GLOBAL_OPT_SHARED_MEMORY = 0x2,
+    /** Negotiate the length-prefixed binary framing with Greengrass Core,
+     * carrying request id, operation and fixed width header fields instead of
+     * the text encoded headers */
+    GG_GLOBAL_OPT_BINARY_FRAMING = 0x4,
+    /** Share one persistent connection to Greengrass Core between all
+     * threads of the process. Requests are tagged with an id and their
+     * responses are routed back to the waiting gg_request, so concurrent
+     * requests neither serialize nor open a connection each */
+    GG_GLOBAL_OPT_MULTIPLEXED_CONNECTION = 0x8,
+    GG_GLOBAL_OPT_RESERVED_PAD = 0x7FFFFFFF
+} gg_global_opt;
+
 /**
  * @brief Flags set for the gg_runtime_start)(.., opt)
  */
@@ -107,6 +170,43 @@ typedef enum gg_runtime_opt {
 	GG_RT_OPT_RESERVED_PAD = 0x7FFFFFFF
 } gg_runtime_opt;
 
+typedef struct _gg_runtime_options *gg_runtime_options;
+
+typedef struct _gg_lambda_completion *gg_lambda_completion;
+
+/**
+ * @brief Describes the order in which a runtime serves pending invocations
+ */
+typedef enum gg_dispatch_order {
+    /** Serve invocations in arrival order (default) */
+    GG_DISPATCH_ORDER_ARRIVAL,
+    /** Serve the invocation with the earliest deadline first. Invocations
+     * without a deadline come after those with one, by descending priority
+     * and then arrival order */
+    GG_DISPATCH_ORDER_DEADLINE,
+
+    GG_DISPATCH_ORDER_RESERVED_MAX,
+    GG_DISPATCH_ORDER_RESERVED_PAD = 0x7FFFFFFF
+} gg_dispatch_order;
+
+/**
+ * @brief Describes the kinds of threads the SDK creates, which can be
+ *        configured separately through gg_runtime_options
+ */
+typedef enum gg_thread_role {
+    /** Thread started by GG_RT_OPT_ASYNC that dispatches invocations */
+    GG_THREAD_ROLE_RUNTIME,
+    /** Threads calling the lambda handler */
+    GG_THREAD_ROLE_WORKER,
+    /** Threads performing IPC with Greengrass Core */
+    GG_THREAD_ROLE_IO,
+    /** Threads forwarding log lines to Greengrass Core */
+    GG_THREAD_ROLE_LOG,
+
+    GG_THREAD_ROLE_RESERVED_MAX,
+    GG_THREAD_ROLE_RESERVED_PAD = 0x7FFFFFFF
+} gg_thread_role;
+
 /**
  * @brief Describes the options to invoke a target lambda
  *
@@ -143,6 +243,23 @@ typedef enum gg_queue_full_policy_options {
 
 typedef struct _gg_publish_options *gg_publish_options;
 
+typedef struct _gg_spool *gg_spool;
+
+/**
+ * @brief Describes what a spool does when a publish does not fit its budget
+ */
+typedef enum gg_spool_overflow_policy {
+    /** Oldest spooled publishes are dropped to make room. Their topics'
+     * dedup hashes are cleared, see gg_publish_options_set_dedup */
+    GG_SPOOL_OVERFLOW_DROP_OLDEST,
+    /** The publish is not spooled and returns request status
+     * GG_REQUEST_AGAIN */
+    GG_SPOOL_OVERFLOW_ERROR,
+
+    GG_SPOOL_OVERFLOW_RESERVED_MAX,
+    GG_SPOOL_OVERFLOW_RESERVED_PAD = 0x7FFFFFFF
+} gg_spool_overflow_policy;
+
 /**
  * @brief Describes log levels could used in **gg_log()**
  */
@@ -164,6 +281,186 @@ typedef enum gg_log_level {
     GG_LOG_RESERVED_PAD = 0x7FFFFFFF
 } gg_log_level;
 
+/**
+ * @brief Describes the per call site state used by **gg_log_ratelimited()**
+ *
+ * Must have static storage duration, one per call site, and be initialized
+ * with GG_LOG_RATELIMIT_INIT. The SDK updates it with atomic operations so
+ * the call site may be shared by any number of threads without locking.
+ * Fields other than the configuration must not be modified by the caller.
+ * The SDK links the call site into a process wide list on its first message,
+ * so the state must stay valid until the process exits.
+ *
+ * @param burst Maximum number of messages logged per interval, 0 for no limit
+ * @param interval_ms Length of the rate limiting interval in milliseconds
+ * @param sample_rate Log only 1 out of every sample_rate messages, 0 or 1 to
+ *        log every message
+ */
+typedef struct gg_log_ratelimit {
+    uint32_t burst;
+    uint32_t interval_ms;
+    uint32_t sample_rate;
+    uint32_t reserved_seen;
+    uint32_t reserved_logged;
+    uint32_t reserved_suppressed;
+    uint64_t reserved_interval_start;
+    struct gg_log_ratelimit *reserved_next;
+} gg_log_ratelimit;
+
+/**
+ * @brief Static initializer for a **gg_log_ratelimit**
+ */
+#define GG_LOG_RATELIMIT_INIT(burst, interval_ms, sample_rate) \
+    { (burst), (interval_ms), (sample_rate), 0, 0, 0, 0, NULL }
+
+/**
+ * @brief Describes the allocator used for all internal SDK allocations
+ *
+ * Every function receives user_data as its last argument. All functions must
+ * be thread safe and must stay valid until the process exits.
+ *
+ * @param malloc_fn Allocate size bytes, NULL when out of memory
+ * @param realloc_fn Resize an allocation made by this allocator, same
+ *        semantics as realloc
+ * @param free_fn Release an allocation made by this allocator, ptr may be NULL
+ * @param aligned_alloc_fn Allocate size bytes aligned to alignment, a power of
+ *        two; the result is released with free_fn
+ * @param user_data Opaque pointer passed through to every function
+ */
+typedef struct gg_allocator {
+    void *(*malloc_fn)(size_t size, void *user_data);
+    void *(*realloc_fn)(void *ptr, size_t size, void *user_data);
+    void (*free_fn)(void *ptr, void *user_data);
+    void *(*aligned_alloc_fn)(size_t alignment, size_t size, void *user_data);
+    void *user_data;
+} gg_allocator;
+
+/**
+ * @brief Describes the SDK APIs tracked by **gg_metrics_snapshot()**
+ */
+typedef enum gg_metrics_api {
+    /** gg_publish and gg_publish_with_options */
+    GG_METRICS_API_PUBLISH,
+    /** gg_invoke */
+    GG_METRICS_API_INVOKE,
+    /** gg_request_read */
+    GG_METRICS_API_REQUEST_READ,
+    /** gg_get_thing_shadow */
+    GG_METRICS_API_GET_THING_SHADOW,
+    /** gg_update_thing_shadow and gg_update_thing_shadow_with_options */
+    GG_METRICS_API_UPDATE_THING_SHADOW,
+    /** gg_delete_thing_shadow */
+    GG_METRICS_API_DELETE_THING_SHADOW,
+    /** gg_get_secret_value */
+    GG_METRICS_API_GET_SECRET_VALUE,
+    /** gg_lambda_handler_read */
+    GG_METRICS_API_LAMBDA_HANDLER_READ,
+    /** gg_lambda_handler_write_response and gg_lambda_handler_write_error */
+    GG_METRICS_API_LAMBDA_HANDLER_WRITE,
+
+    GG_METRICS_API_RESERVED_MAX,
+    GG_METRICS_API_RESERVED_PAD = 0x7FFFFFFF
+} gg_metrics_api;
+
+/** Number of buckets in each latency histogram of gg_metrics_api_stats */
+#define GG_METRICS_LATENCY_BUCKETS 128
+
+/** Number of request status counters, indexed by gg_request_status */
+#define GG_METRICS_REQUEST_STATUS_SLOTS 16
+
+/**
+ * @brief Describes the counters and latency histograms of one SDK API
+ *
+ * Latencies are in microseconds and bucketed log-linearly: buckets 0 to 3
+ * hold 0 to 3us, after which every power of two is split into 4 equally
+ * sized buckets. Use **gg_metrics_bucket_lower_bound()** to get the lower
+ * bound of a bucket.
+ *
+ * @param calls Number of completed calls
+ * @param errors Number of calls that returned an error other than GGE_SUCCESS
+ * @param bytes_sent Payload bytes sent to Greengrass Core
+ * @param bytes_received Payload bytes received from Greengrass Core
+ * @param request_status Number of calls per gg_request_status returned in
+ *        gg_request_result, e.g. request_status[GG_REQUEST_AGAIN]
+ * @param total_latency Histogram of the time spent in the call
+ * @param core_latency Histogram of the part of total_latency spent waiting on
+ *        Greengrass Core
+ */
+typedef struct gg_metrics_api_stats {
+    uint64_t calls;
+    uint64_t errors;
+    uint64_t bytes_sent;
+    uint64_t bytes_received;
+    uint64_t request_status[GG_METRICS_REQUEST_STATUS_SLOTS];
+    uint64_t total_latency[GG_METRICS_LATENCY_BUCKETS];
+    uint64_t core_latency[GG_METRICS_LATENCY_BUCKETS];
+} gg_metrics_api_stats;
+
+/**
+ * @brief Describes AWS credentials issued by the Greengrass Token Exchange
+ *        Service
+ * @param access_key_id Null-terminated string AWS access key id
+ * @param secret_access_key Null-terminated string AWS secret access key
+ * @param session_token Null-terminated string AWS session token
+ * @param expiration Expiration time in seconds since the Unix epoch
+ */
+typedef struct gg_tes_credentials {
+    const char *access_key_id;
+    const char *secret_access_key;
+    const char *session_token;
+    int64_t expiration;
+} gg_tes_credentials;
+
+typedef struct _gg_json_reader *gg_json_reader;
+
+/**
+ * @brief Describes the kinds of tokens returned by a gg_json_reader
+ */
+typedef enum gg_json_token_type {
+    /** No token, more input must be fed to the reader */
+    GG_JSON_TOKEN_NONE,
+    /** '{' */
+    GG_JSON_TOKEN_OBJECT_BEGIN,
+    /** '}' */
+    GG_JSON_TOKEN_OBJECT_END,
+    /** '[' */
+    GG_JSON_TOKEN_ARRAY_BEGIN,
+    /** ']' */
+    GG_JSON_TOKEN_ARRAY_END,
+    /** Object key, unescaped in data */
+    GG_JSON_TOKEN_KEY,
+    /** String value, unescaped in data */
+    GG_JSON_TOKEN_STRING,
+    /** Number value, as written in the document in data */
+    GG_JSON_TOKEN_NUMBER,
+    /** true */
+    GG_JSON_TOKEN_TRUE,
+    /** false */
+    GG_JSON_TOKEN_FALSE,
+    /** null */
+    GG_JSON_TOKEN_NULL,
+    /** The document is complete, or the searched path is not in it */
+    GG_JSON_TOKEN_END,
+
+    GG_JSON_TOKEN_RESERVED_MAX,
+    GG_JSON_TOKEN_RESERVED_PAD = 0x7FFFFFFF
+} gg_json_token_type;
+
+/**
+ * @brief Describes one token returned by a gg_json_reader
+ * @param type Kind of token
+ * @param depth Nesting depth of the token, 0 for the top level value
+ * @param data Text of keys, strings and numbers, NULL for other tokens. Not
+ *        null-terminated. Valid until the next call on the reader
+ * @param data_size Size of data
+ */
+typedef struct gg_json_token {
+    gg_json_token_type type;
+    uint32_t depth;
+    const char *data;
+    size_t data_size;
+} gg_json_token;
+
 /***************************************
 **            Global Methods          **
 ***************************************/
@@ -171,7 +468,8 @@ typedef enum gg_log_level {
 
 /**
  * @brief Initialize Greengrass internal global variables
- * @param opt Reserved for future use. Must be set to 0.
+ * @param opt Mask flags of gg_global_opt options, 0 for default. Non-zero
+ *        values need a 1.3 or later library, older ones may return an error
  * @return Greengrass error code
  * @note THIS IS NOT THREAD SAFE and must be called when there is only a single
  *       main thread executing.
@@ -181,6 +479,37 @@ typedef enum gg_log_level {
  */
 gg_error gg_global_init(uint32_t opt);
 
+/**
+ * @brief Initialize Greengrass internal global variables with a custom
+ *        allocator
+ *
+ * Same as **gg_global_init()** except that every allocation the SDK makes
+ * internally, including those behind gg_request_init,
+ * gg_publish_options_init and response buffering, goes through allocator
+ * instead of the system malloc. When allocator returns NULL the SDK call
+ * fails with GGE_OUT_OF_MEMORY.
+ *
+ * @param opt Mask flags of gg_global_opt options, 0 for default
+ * @param allocator Allocator to use, copied by the SDK. All functions must be
+ *        set. NULL selects the system allocator.
+ * @return Greengrass error code
+ * @note THIS IS NOT THREAD SAFE and has the same requirements as
+ *       gg_global_init. Call only one of the two, once.
+ */
+gg_error gg_global_init_with_allocator(uint32_t opt,
+                                       const gg_allocator *allocator);
+
+/**
+ * @brief Get the gg_global_opt flags in effect after initialization
+ *
+ * Flags passed to gg_global_init that the kernel or Greengrass Core does not
+ * support are cleared.
+ *
+ * @param opt Destination for the mask of gg_global_opt flags in effect
+ * @return Greengrass error code
+ */
+gg_error gg_global_get_opt(uint32_t *opt);
+
 /***************************************
 **           Logging Methods          **
 ***************************************/
@@ -191,9 +520,86 @@ gg_error gg_global_init(uint32_t opt);
  * @param format Similar to printf
  * @param ... Similar to printf
  * @return Greengrass error code
+ * @note Thread safe. Lines logged concurrently are never interleaved.
  */
 gg_error gg_log(gg_log_level level, const char *format, ...);
 
+/**
+ * @brief Log message to Greengrass Core subject to call site rate limiting
+ *        and sampling
+ *
+ * Messages are first sampled according to ratelimit->sample_rate and then
+ * limited to ratelimit->burst messages per ratelimit->interval_ms. When an
+ * interval in which messages were suppressed ends, a summary line with the
+ * number of suppressed messages is logged by the SDK log thread, whether or
+ * not the call site logs again.
+ *
+ * @param ratelimit Call site state initialized with GG_LOG_RATELIMIT_INIT
+ * @param level Level of message that can be filtered based on settings
+ * @param format Similar to printf
+ * @param ... Similar to printf
+ * @return Greengrass error code, GGE_SUCCESS also when the message was
+ *         suppressed
+ * @note Dropped messages are not formatted, so a suppressed call costs a
+ *       few atomic operations.
+ */
+gg_error gg_log_ratelimited(gg_log_ratelimit *ratelimit, gg_log_level level,
+                            const char *format, ...);
+
+/**
+ * @brief Log the summary of every call site with suppressed messages now
+ *
+ * Summaries are otherwise logged when the call site's interval ends. Call it
+ * before the process exits so suppressed counts are not lost.
+ *
+ * @return Greengrass error code
+ */
+gg_error gg_log_ratelimit_flush(void);
+
+#if (defined(__cplusplus) && __cplusplus >= 201103L) || \
+    (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L)
+/**
+ * @brief Log message with rate limiting state private to this call site
+ *
+ * Convenience wrapper around **gg_log_ratelimited()** which declares the
+ * static gg_log_ratelimit for the call site. Requires C99 or C++11. In C,
+ * burst, interval_ms and sample_rate must be constant expressions since they
+ * initialize a static object.
+ */
+#define GG_LOG_RATELIMITED(level, burst, interval_ms, sample_rate, ...) \
+    do { \
+        static gg_log_ratelimit _gg_log_ratelimit = \
+            GG_LOG_RATELIMIT_INIT(burst, interval_ms, sample_rate); \
+        gg_log_ratelimited(&_gg_log_ratelimit, level, __VA_ARGS__); \
+    } while(0)
+#endif
+
+/***************************************
+**           Metrics Methods          **
+***************************************/
+
+/**
+ * @brief Get the cumulative counters and latency histograms of an SDK API
+ *
+ * Metrics are always collected, into per thread shards that are only merged
+ * when this method is called. Counters are never reset; callers publishing
+ * them periodically should compute the difference to the previous snapshot.
+ *
+ * @param api API to get metrics for
+ * @param stats Destination for the merged metrics
+ * @return Greengrass error code
+ */
+gg_error gg_metrics_snapshot(gg_metrics_api api, gg_metrics_api_stats *stats);
+
+/**
+ * @brief Get the lower bound of a latency histogram bucket
+ * @param bucket Bucket index, less than GG_METRICS_LATENCY_BUCKETS
+ * @param lower_bound_us Destination for the lower bound in microseconds
+ * @return Greengrass error code
+ */
+gg_error gg_metrics_bucket_lower_bound(uint32_t bucket,
+                                       uint64_t *lower_bound_us);
+
 /***************************************
 **         gg_request Methods         **
 ***************************************/
@@ -203,16 +609,96 @@ gg_error gg_log(gg_log_level level, const char *format, ...);
  * @param ggreq Pointer to context to be initialized
  * @return Greengrass error code
  * @note Need to call gg_request_close on ggreq when done using it
+ * @note With GG_GLOBAL_OPT_MULTIPLEXED_CONNECTION in effect, requests do not
+ *       own a connection and any number of them may be outstanding
+ *       concurrently on different threads.
  */
 gg_error gg_request_init(gg_request *ggreq);
 
+/**
+ * @brief Initialize the context for managing the request inside an arena
+ *
+ * Same as **gg_request_init()** except that the request and the buffers used
+ * to read its response are allocated from arena.
+ *
+ * @param arena Arena to allocate from, usually the invocation arena from
+ *        **gg_lambda_context_get_arena()** in a lambda handler
+ * @param ggreq Pointer to context to be initialized
+ * @return Greengrass error code
+ * @note gg_request_close must still be called on ggreq, before the arena is
+ *       reset.
+ */
+gg_error gg_request_init_with_arena(gg_arena arena, gg_request *ggreq);
+
 /**
  * @brief Close a request context that was created by gg_request_init
  * @param ggreq Context to be closed
  * @return Greengrass error code
+ * @note ggreq must not be used by another thread at the same time
  */
 gg_error gg_request_close(gg_request ggreq);
 
+/**
+ * @brief Sets a timeout on the blocking calls made with a request
+ *
+ * Applies to every later gg_invoke, gg_publish_with_options, gg_publish,
+ * gg_xxx_thing_shadow and gg_get_secret_value call made with ggreq. A call
+ * that does not complete in time returns GGE_SUCCESS with request status
+ * GG_REQUEST_TIMEOUT, after releasing what it holds in the SDK.
+ *
+ * @param ggreq Request to be configured
+ * @param timeout_ms Timeout in milliseconds, 0 to wait without bound
+ *        (default)
+ * @return Greengrass error code
+ */
+gg_error gg_request_set_timeout(gg_request ggreq, uint32_t timeout_ms);
+
+/**
+ * @brief Sets the priority of the invocations made with a request
+ *
+ * Read by the invoked lambda with **gg_lambda_context_get_priority()**.
+ * Receiving runtimes using
+ * GG_DISPATCH_ORDER_DEADLINE serve higher priorities first among
+ * invocations with equal deadlines.
+ *
+ * @param ggreq Request to be configured
+ * @param priority Priority, higher is more urgent, 0 by default
+ * @return Greengrass error code
+ */
+gg_error gg_request_set_priority(gg_request ggreq, uint32_t priority);
+
+/**
+ * @brief Sets the deadline of the invocations made with a request
+ *
+ * Read by the invoked lambda with **gg_lambda_context_get_deadline()**.
+ * Receiving runtimes using GG_DISPATCH_ORDER_DEADLINE serve the earliest
+ * deadline first.
+ *
+ * @param ggreq Request to be configured
+ * @param deadline_ms Deadline in milliseconds after the invoke, 0 for the
+ *        request timeout if set, otherwise no deadline (default)
+ * @return Greengrass error code
+ */
+gg_error gg_request_set_deadline(gg_request ggreq, uint32_t deadline_ms);
+
+/**
+ * @brief Cancel the call in progress on a request
+ *
+ * The call blocked on ggreq, if any, returns promptly with GGE_SUCCESS and
+ * request status GG_REQUEST_CANCELLED, and later calls with ggreq fail
+ * immediately the same way. The request must still be closed with
+ * gg_request_close.
+ *
+ * @param ggreq Request to be cancelled
+ * @return Greengrass error code
+ * @note Thread safe, unlike other uses of ggreq. Cancelling a request that
+ *       already completed has no effect on its result.
+ * @note Not safe against gg_request_close: the thread owning ggreq must keep
+ *       it open until every concurrent gg_request_cancel on it has returned,
+ *       otherwise cancel may use the freed request.
+ */
+gg_error gg_request_cancel(gg_request ggreq);
+
 /**
  * @brief Read the data from a request. This method should be called
  *        till amount_read is zero.
@@ -221,11 +707,29 @@ gg_error gg_request_close(gg_request ggreq);
  * @param buffer Destination for read data
  * @param buffer_size Size of buffer
  * @param amount_read Destination for amount of data read into buffer
- * @return Greengrass error code
+ * @return Greengrass error code, GGE_INVALID_STATE when the request timed out
+ *         or was cancelled
+ * @note ggreq must not be used by another thread at the same time
  */
 gg_error gg_request_read(gg_request ggreq, void *buffer, size_t buffer_size,
                          size_t *amount_read);
 
+/**
+ * @brief Get the whole response of a request without copying it
+ *
+ * When the response was passed through shared memory, this returns its
+ * read-only mapping. Otherwise the SDK reads the response into a buffer
+ * owned by the request. Must not be combined with gg_request_read on the same
+ * request.
+ *
+ * @param ggreq Provides context about the request
+ * @param response Destination for the response, valid until gg_request_close
+ * @param response_size Destination for the size of response
+ * @return Greengrass error code
+ */
+gg_error gg_request_read_mapped(gg_request ggreq, const void **response,
+                                size_t *response_size);
+
 /***************************************
 **           Runtime Methods          **
 ***************************************/
@@ -237,15 +741,263 @@ gg_error gg_request_read(gg_request ggreq, void *buffer, size_t buffer_size,
  */
 typedef void (*gg_lambda_handler)(const gg_lambda_context *cxt);
 
+/**
+ * @brief Describes one invocation delivered to a gg_lambda_batch_handler
+ * @param context Details about the invocation
+ * @param payload Whole event payload, valid until the batch handler returns
+ * @param payload_size Size of payload
+ */
+typedef struct gg_lambda_event {
+    const gg_lambda_context *context;
+    const void *payload;
+    size_t payload_size;
+} gg_lambda_event;
+
+/**
+ * @brief Handler signature that will be called with the invocations queued
+ *        for the lambda, in arrival order
+ * @param events Array of invocations, valid until the handler returns
+ * @param event_count Number of entries in events, at least 1
+ */
+typedef void (*gg_lambda_batch_handler)(const gg_lambda_event *events,
+                                        size_t event_count);
+
+/**
+ * @brief Callback signature run once before the first invocation
+ * @param user_data Pointer set with gg_runtime_options_set_user_data
+ * @return Greengrass error code, anything but GGE_SUCCESS stops the runtime
+ */
+typedef gg_error (*gg_init_callback)(void *user_data);
+
+/**
+ * @brief Callback signature run once while the runtime drains on SIGTERM
+ * @param user_data Pointer set with gg_runtime_options_set_user_data
+ */
+typedef void (*gg_shutdown_callback)(void *user_data);
+
 /**
  * @brief Registers the lambda handler and start Greengrass lambda runtime
  *
  * @param handler Customer lambda code to be run when subscription is triggered
  * @param opt Mask flags of gg_runtime_opt options, 0 for default
  * @note Must be called. This uses and will overwrite the SIGTERM handler
+ * @note Calls gg_runtime_start_with_options with opts==NULL
  */
 gg_error gg_runtime_start(gg_lambda_handler handler, uint32_t opt);
 
+/**
+ * @brief Registers the lambda handler and start Greengrass lambda runtime
+ *        configured by runtime options
+ *
+ * @param handler Customer lambda code to be run when subscription is triggered
+ * @param opt Mask flags of gg_runtime_opt options, 0 for default
+ * @param opts Runtime options, NULL for default. The runtime copies what it
+ *        needs, so opts can be freed once this returns or, with
+ *        GG_RT_OPT_ASYNC, once the runtime thread is started.
+ * @return Greengrass error code, GGE_INVALID_STATE when a thread setting
+ *         cannot be applied, e.g. SCHED_FIFO without CAP_SYS_NICE
+ * @note Must be called instead of gg_runtime_start. This uses and will
+ *       overwrite the SIGTERM handler
+ * @note On SIGTERM the runtime drains: it stops accepting invocations, waits
+ *       for running handlers, runs the shutdown callback, then flushes
+ *       outstanding requests, buffered publishes and buffered log lines.
+ *       Draining is bounded by the drain timeout, after which the runtime
+ *       returns GGE_TERMINATE (or exits the process with GG_RT_OPT_ASYNC)
+ *       and remaining work is dropped.
+ */
+gg_error gg_runtime_start_with_options(gg_lambda_handler handler,
+        uint32_t opt, const gg_runtime_options opts);
+
+/**
+ * @brief Registers a batch lambda handler and start Greengrass lambda runtime
+ *
+ * Instead of one call per invocation, the handler is called with every
+ * invocation already queued for the lambda, up to the maximum batch size,
+ * with their payloads fully read. The runtime never waits to fill a batch,
+ * so an idle lambda still gets single invocations without added latency.
+ *
+ * @param handler Customer lambda code to be run for each batch
+ * @param opt Mask flags of gg_runtime_opt options, 0 for default
+ * @param opts Runtime options, NULL for default. Topic handlers are not
+ *        supported in batch mode
+ * @return Greengrass error code, GGE_INVALID_PARAMETER when opts has topic
+ *         handlers
+ * @note Must be called instead of gg_runtime_start. This uses and will
+ *       overwrite the SIGTERM handler
+ */
+gg_error gg_runtime_start_batch(gg_lambda_batch_handler handler,
+        uint32_t opt, const gg_runtime_options opts);
+
+/**
+ * @brief Initialize the runtime options
+ * @param opts Pointer to runtime options to be initialized
+ * @return Greengrass error code
+ * @note Need to call gg_runtime_options_free on opts when done using it
+ */
+gg_error gg_runtime_options_init(gg_runtime_options *opts);
+
+/**
+ * @brief Free a runtime options that was created by gg_runtime_options_init
+ * @param opts Runtime options to be freed
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_free(gg_runtime_options opts);
+
+/**
+ * @brief Sets the number of worker threads calling the lambda handler
+ *        concurrently
+ * @param opts Runtime options to be configured
+ * @param worker_count Number of worker threads, 1 by default
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_worker_count(gg_runtime_options opts,
+        uint32_t worker_count);
+
+/**
+ * @brief Registers a lambda handler for messages matching an MQTT topic filter
+ *
+ * Topic filters are compiled into a trie when the runtime starts, so routing
+ * a message costs one walk over its topic levels. When several filters match,
+ * the most specific one wins: at each level an exact match is preferred over
+ * '+', and '+' over '#'. Messages matching no filter, and direct invocations,
+ * go to the handler passed to gg_runtime_start_with_options.
+ *
+ * @param opts Runtime options to be configured
+ * @param topic_filter Null-terminated string MQTT topic filter, e.g.
+ *        "sensors/+/temperature" or "commands/#"
+ * @param handler Customer lambda code to be run for matching messages
+ * @return Greengrass error code, GGE_INVALID_PARAMETER for a malformed filter
+ *         or one that is already registered
+ */
+gg_error gg_runtime_options_add_topic_handler(gg_runtime_options opts,
+        const char *topic_filter, gg_lambda_handler handler);
+
+/**
+ * @brief Sets the callback run once before the first invocation
+ *
+ * Use it for expensive per process setup such as creating clients, which can
+ * then be reached from every invocation through
+ * **gg_lambda_context_get_user_data()**.
+ *
+ * @param opts Runtime options to be configured
+ * @param callback Called on a runtime thread after thread settings are
+ *        applied. When it fails, gg_runtime_start_with_options returns its
+ *        error without accepting invocations
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_init_callback(gg_runtime_options opts,
+        gg_init_callback callback);
+
+/**
+ * @brief Sets how long the runtime may drain after receiving SIGTERM
+ * @param opts Runtime options to be configured
+ * @param timeout_ms Drain deadline in milliseconds, 0 to stop without
+ *        draining. 5000 by default
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_drain_timeout(gg_runtime_options opts,
+        uint32_t timeout_ms);
+
+/**
+ * @brief Sets the callback run once while the runtime drains on SIGTERM
+ * @param opts Runtime options to be configured
+ * @param callback Called after running handlers returned, on a runtime
+ *        thread. The SDK may still be used from it, e.g. to publish final
+ *        telemetry, but it must return before the drain timeout. Not
+ *        called when the init callback failed
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_shutdown_callback(gg_runtime_options opts,
+        gg_shutdown_callback callback);
+
+/**
+ * @brief Sets the pointer passed to the runtime callbacks and returned to
+ *        every invocation by gg_lambda_context_get_user_data
+ * @param opts Runtime options to be configured
+ * @param user_data Pointer owned by the caller, NULL by default
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_user_data(gg_runtime_options opts,
+        void *user_data);
+
+/**
+ * @brief Sets how many pending invocations are read ahead while handlers run
+ *
+ * An I/O thread receives the context and whole payload of up to
+ * prefetch_count invocations queued behind the running ones, so the next
+ * handler call starts without waiting on Greengrass Core and
+ * gg_lambda_handler_read copies from memory.
+ *
+ * @param opts Runtime options to be configured
+ * @param prefetch_count Number of invocations to read ahead, 0 to disable
+ *        (default)
+ * @return Greengrass error code
+ * @note Prefetched payloads are buffered in full, so memory use grows with
+ *       prefetch_count times the payload size.
+ */
+gg_error gg_runtime_options_set_prefetch_count(gg_runtime_options opts,
+        uint32_t prefetch_count);
+
+/**
+ * @brief Sets the order in which pending invocations are served
+ *
+ * Invocations are only pending in the runtime, and can be reordered, when
+ * it reads ahead with gg_runtime_options_set_prefetch_count or runs several
+ * workers with gg_runtime_options_set_worker_count.
+ *
+ * @param opts Runtime options to be configured
+ * @param order Dispatch order, GG_DISPATCH_ORDER_ARRIVAL by default
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_dispatch_order(gg_runtime_options opts,
+        gg_dispatch_order order);
+
+/**
+ * @brief Sets the largest number of invocations passed to a batch handler
+ * @param opts Runtime options to be configured
+ * @param max_batch_size Maximum number of events per call, 16 by default
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_max_batch_size(gg_runtime_options opts,
+        uint32_t max_batch_size);
+
+/**
+ * @brief Sets the cpus the threads of a role may run on
+ * @param opts Runtime options to be configured
+ * @param role Threads to be configured
+ * @param cpus Array of cpu indexes as used by sched_setaffinity
+ * @param cpu_count Number of entries in cpus, 0 to run on any cpu (default)
+ * @return Greengrass error code
+ * @note Helper threads already started by gg_global_init are moved when the
+ *       runtime starts.
+ */
+gg_error gg_runtime_options_set_thread_affinity(gg_runtime_options opts,
+        gg_thread_role role, const uint32_t *cpus, size_t cpu_count);
+
+/**
+ * @brief Sets the scheduling policy and priority of the threads of a role
+ * @param opts Runtime options to be configured
+ * @param role Threads to be configured
+ * @param policy Scheduling policy from sched.h, e.g. SCHED_FIFO. SCHED_OTHER
+ *        by default
+ * @param priority Static priority for SCHED_FIFO and SCHED_RR, must be 0 for
+ *        other policies
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_thread_scheduling(gg_runtime_options opts,
+        gg_thread_role role, int policy, int priority);
+
+/**
+ * @brief Sets the name of the threads of a role, as shown by ps and top
+ * @param opts Runtime options to be configured
+ * @param role Threads to be configured
+ * @param name Null-terminated string of at most 12 characters. The SDK
+ *        appends "-<n>" for roles with several threads
+ * @return Greengrass error code
+ */
+gg_error gg_runtime_options_set_thread_name(gg_runtime_options opts,
+        gg_thread_role role, const char *name);
+
 /**
  * @brief Read the data from the invoker of the lambda. This method should be called
  *        till amount_read is zero.
@@ -255,10 +1007,29 @@ gg_error gg_runtime_start(gg_lambda_handler handler, uint32_t opt);
  * @param amount_read Destination for amount of data read into buffer
  * @return Greengrass error code
  * @note This should only be used in the lambda handler
+ * @note The handler_* functions act on the invocation of the calling thread
+ *       and fail with GGE_INVALID_STATE on threads not running a handler.
  */
 gg_error gg_lambda_handler_read(void *buffer, size_t buffer_size,
                                 size_t *amount_read);
 
+/**
+ * @brief Get the whole event payload from the invoker of the lambda without
+ *        copying it
+ *
+ * When the payload was passed through shared memory, this returns its
+ * read-only mapping. Otherwise the SDK reads the payload into a buffer owned
+ * by the invocation. Must not be combined with gg_lambda_handler_read in the
+ * same invocation.
+ *
+ * @param payload Destination for the payload, valid until the handler returns
+ * @param payload_size Destination for the size of payload
+ * @return Greengrass error code
+ * @note This should only be used in the lambda handler
+ */
+gg_error gg_lambda_handler_read_mapped(const void **payload,
+                                       size_t *payload_size);
+
 /**
  * @brief Write response to the invoker of the lambda
  * @param response Response data to be written
@@ -279,6 +1050,356 @@ gg_error gg_lambda_handler_write_response(const void *response,
  */
 gg_error gg_lambda_handler_write_error(const char *error_message);
 
+/**
+ * @brief Detach the current invocation from the lambda handler so it can be
+ *        completed after the handler returns
+ *
+ * Once the handler returns, the runtime accepts the next invocation while the
+ * detached one stays open until completion is written to, from any thread.
+ * The event payload must be read before detaching; whatever is left unread is
+ * discarded. cxt and memory from its arena are still released when the
+ * handler returns, so copy what is needed to complete the invocation.
+ *
+ * @param completion Destination for the token completing the invocation
+ * @return Greengrass error code
+ * @note This should only be used in the lambda handler, at most once per
+ *       invocation and not in batch mode. After detaching,
+ *       gg_lambda_handler_write_response and gg_lambda_handler_write_error
+ *       fail with GGE_INVALID_STATE.
+ * @note Detached invocations still open on SIGTERM are waited for during
+ *       the drain.
+ */
+gg_error gg_lambda_handler_detach(gg_lambda_completion *completion);
+
+/**
+ * @brief Complete a detached invocation with a response
+ * @param completion Token returned by gg_lambda_handler_detach, released by
+ *        this call
+ * @param response Response data to be written
+ * @param response_size Amount of data stored in response
+ * @return Greengrass error code
+ * @note Thread safe. Each completion must be completed exactly once, with
+ *       either this method or gg_lambda_completion_write_error.
+ */
+gg_error gg_lambda_completion_write_response(gg_lambda_completion completion,
+        const void *response, size_t response_size);
+
+/**
+ * @brief Complete a detached invocation with an error message
+ * @param completion Token returned by gg_lambda_handler_detach, released by
+ *        this call
+ * @param error_message Null-terminated string error message to be written
+ * @return Greengrass error code
+ * @note Thread safe. Each completion must be completed exactly once, with
+ *       either this method or gg_lambda_completion_write_response.
+ * @note The caller's invoke will return result GG_REQUEST_HANDLED
+ *       in the gg_request_result struct instead of GG_REQUEST_SUCCESS.
+ */
+gg_error gg_lambda_completion_write_error(gg_lambda_completion completion,
+        const char *error_message);
+
+/**
+ * @brief Write response to the invoker of one event of a batch
+ * @param index Index of the event in the events array of the batch handler
+ * @param response Response data to be written
+ * @param response_size Amount of data stored in response
+ * @return Greengrass error code
+ * @note This should only be used in the batch lambda handler. Events
+ *       without a written response or error get an empty response.
+ */
+gg_error gg_lambda_batch_write_response(size_t index, const void *response,
+                                        size_t response_size);
+
+/**
+ * @brief Write error message to the invoker of one event of a batch
+ * @param index Index of the event in the events array of the batch handler
+ * @param error_message Null-terminated string error message to be written
+ * @return Greengrass error code
+ * @note This should only be used in the batch lambda handler
+ * @note The caller's invoke will return result GG_REQUEST_HANDLED
+ *       in the gg_request_result struct instead of GG_REQUEST_SUCCESS.
+ */
+gg_error gg_lambda_batch_write_error(size_t index, const char *error_message);
+
+/**
+ * @brief Get the scratch memory arena of the invocation
+ * @param cxt Context passed to the lambda handler
+ * @param arena Destination for the arena, see **gg_arena_alloc()**. It is
+ *        reset when the handler returns
+ * @return Greengrass error code
+ * @note This should only be used in the lambda handler
+ */
+gg_error gg_lambda_context_get_arena(const gg_lambda_context *cxt,
+        gg_arena *arena);
+
+/**
+ * @brief Get the user data of the runtime running the invocation
+ * @param cxt Context passed to the lambda handler
+ * @param user_data Destination for the pointer set with
+ *        gg_runtime_options_set_user_data, NULL when the runtime was started
+ *        without one
+ * @return Greengrass error code
+ * @note This should only be used in the lambda handler
+ */
+gg_error gg_lambda_context_get_user_data(const gg_lambda_context *cxt,
+        void **user_data);
+
+/**
+ * @brief Get the topic of the invocation
+ * @param cxt Context passed to the lambda handler
+ * @param topic Destination for the null-terminated topic the message was
+ *        published to, NULL when the lambda was invoked directly
+ * @param wildcards Destination for the null-terminated strings captured by
+ *        the wildcards of the topic filter the handler was registered for,
+ *        in order. '+' captures one level, '#' captures the remaining levels.
+ *        May be NULL when not needed
+ * @param wildcard_count Destination for the number of entries in wildcards.
+ *        May be NULL when not needed
+ * @return Greengrass error code
+ * @note This should only be used in the lambda handler. The strings are valid
+ *       until the handler returns
+ */
+gg_error gg_lambda_context_get_topic(const gg_lambda_context *cxt,
+        const char **topic, const char *const **wildcards,
+        size_t *wildcard_count);
+
+/**
+ * @brief Get the priority of the invocation
+ * @param cxt Context passed to the lambda handler
+ * @param priority Destination for the priority set by the invoker with
+ *        gg_request_set_priority, 0 by default
+ * @return Greengrass error code
+ * @note This should only be used in the lambda handler
+ */
+gg_error gg_lambda_context_get_priority(const gg_lambda_context *cxt,
+        uint32_t *priority);
+
+/**
+ * @brief Get the deadline of the invocation
+ * @param cxt Context passed to the lambda handler
+ * @param deadline_ms Destination for the deadline set by the invoker in
+ *        milliseconds after the invoke, 0 when there is none
+ * @param dispatch_lateness_us Destination for the time from the deadline to
+ *        the start of the handler, negative when started before the
+ *        deadline, 0 when there is no deadline. May be NULL when not needed
+ * @return Greengrass error code
+ * @note This should only be used in the lambda handler
+ */
+gg_error gg_lambda_context_get_deadline(const gg_lambda_context *cxt,
+        uint32_t *deadline_ms, int64_t *dispatch_lateness_us);
+
+/**
+ * @brief Get the decoded JSON client context of the invocation
+ *
+ * cxt->client_context is base64-encoded JSON. It is decoded on the first call
+ * to this method or **gg_lambda_context_get_client_context_value()** for the
+ * invocation, and the result is cached for later calls.
+ *
+ * @param cxt Context passed to the lambda handler
+ * @param json Destination for the null-terminated JSON, NULL when the
+ *        invocation has no client context. Valid until the handler returns
+ * @param json_size Destination for the length of json
+ * @return Greengrass error code, GGE_INVALID_PARAMETER when the client
+ *         context is not valid base64-encoded JSON
+ * @note This should only be used in the lambda handler
+ */
+gg_error gg_lambda_context_get_client_context(const gg_lambda_context *cxt,
+        const char **json, size_t *json_size);
+
+/**
+ * @brief Get one value of the client context of the invocation
+ *
+ * The client context is decoded and parsed into a key/value view on the
+ * first call for the invocation; later lookups use the cached view.
+ *
+ * @param cxt Context passed to the lambda handler
+ * @param path Null-terminated string of object keys separated by '.', e.g.
+ *        "custom.value"
+ * @param value Destination for the null-terminated value, NULL when path is
+ *        not present. Strings are unescaped, other values are returned as
+ *        JSON text. Valid until the handler returns
+ * @param value_size Destination for the length of value
+ * @return Greengrass error code, GGE_INVALID_PARAMETER when the client
+ *         context is not valid base64-encoded JSON
+ * @note This should only be used in the lambda handler
+ */
+gg_error gg_lambda_context_get_client_context_value(
+        const gg_lambda_context *cxt, const char *path, const char **value,
+        size_t *value_size);
+
+/**
+ * @brief Allocate scratch memory from an arena
+ *
+ * Allocations are carved out of blocks owned by the arena and are never freed
+ * individually. The arena of a gg_lambda_context is reset in constant time
+ * once the lambda handler returns, which releases every allocation made from
+ * it during that invocation.
+ *
+ * @param arena Arena to allocate from, usually the invocation arena from
+ *        **gg_lambda_context_get_arena()**
+ * @param size Number of bytes to allocate
+ * @param alignment Alignment of the allocation, a power of two, 0 for the
+ *        alignment of any scalar type
+ * @param ptr Destination for the allocated memory
+ * @return Greengrass error code
+ * @note An arena is not thread safe and belongs to the thread running the
+ *       invocation.
+ */
+gg_error gg_arena_alloc(gg_arena arena, size_t size, size_t alignment,
+                        void **ptr);
+
+/***************************************
+**          Encoding Methods          **
+***************************************/
+
+/**
+ * @brief Size of the buffer needed by gg_base64_encode for data_size bytes,
+ *        including the null terminator
+ */
+#define GG_BASE64_ENCODED_SIZE(data_size) (((data_size) + 2) / 3 * 4 + 1)
+
+/**
+ * @brief Upper bound of the size decoded by gg_base64_decode from
+ *        encoded_size characters
+ */
+#define GG_BASE64_DECODED_SIZE(encoded_size) ((encoded_size) / 4 * 3 + 3)
+
+/**
+ * @brief Encode data as padded base64, e.g. to build
+ *        gg_invoke_options.customer_context
+ * @param data Data to be encoded
+ * @param data_size Size of data
+ * @param buffer Destination for the null-terminated encoded string
+ * @param buffer_size Size of buffer, at least GG_BASE64_ENCODED_SIZE(data_size)
+ * @param amount_written Destination for the length of the encoded string
+ * @return Greengrass error code
+ * @note Uses SIMD instructions when the cpu supports them.
+ */
+gg_error gg_base64_encode(const void *data, size_t data_size, char *buffer,
+                          size_t buffer_size, size_t *amount_written);
+
+/**
+ * @brief Decode base64, padded or not
+ * @param encoded Base64 characters to be decoded
+ * @param encoded_size Number of characters in encoded
+ * @param buffer Destination for the decoded data
+ * @param buffer_size Size of buffer, at least
+ *        GG_BASE64_DECODED_SIZE(encoded_size)
+ * @param amount_written Destination for the amount of data decoded
+ * @return Greengrass error code, GGE_INVALID_PARAMETER when encoded is not
+ *         valid base64
+ * @note Uses SIMD instructions when the cpu supports them.
+ */
+gg_error gg_base64_decode(const char *encoded, size_t encoded_size,
+                          void *buffer, size_t buffer_size,
+                          size_t *amount_written);
+
+/***************************************
+**            JSON Methods            **
+***************************************/
+
+/**
+ * @brief Initialize a streaming JSON reader
+ *
+ * The reader tokenizes a document fed in chunks of any size, such as those
+ * produced by gg_request_read, without buffering the document. Scanning for
+ * structural characters uses SSE2 or NEON when available, with a scalar
+ * fallback. All memory is allocated here; feeding and reading tokens never
+ * allocates.
+ *
+ * @param reader Pointer to reader to be initialized
+ * @param max_token_size Largest key, string or number the reader can return,
+ *        which bounds the memory used to join tokens split across chunks
+ * @return Greengrass error code
+ * @note Need to call gg_json_reader_free on reader when done using it. A
+ *       reader must only be used by one thread at a time.
+ */
+gg_error gg_json_reader_init(gg_json_reader *reader, size_t max_token_size);
+
+/**
+ * @brief Free a reader that was created by gg_json_reader_init
+ * @param reader Reader to be freed
+ * @return Greengrass error code
+ */
+gg_error gg_json_reader_free(gg_json_reader reader);
+
+/**
+ * @brief Reset a reader to read a new document
+ * @param reader Reader to be reset
+ * @return Greengrass error code
+ */
+gg_error gg_json_reader_reset(gg_json_reader reader);
+
+/**
+ * @brief Feed the next chunk of the document to a reader
+ * @param reader Reader to be fed
+ * @param chunk Next bytes of the document, must stay valid until the reader
+ *        returns a GG_JSON_TOKEN_NONE token
+ * @param chunk_size Size of chunk, 0 to signal the end of the document
+ * @return Greengrass error code
+ */
+gg_error gg_json_reader_feed(gg_json_reader reader, const void *chunk,
+                             size_t chunk_size);
+
+/**
+ * @brief Get the next token of the document
+ * @param reader Reader to read from
+ * @param token Destination for the token, GG_JSON_TOKEN_NONE when the fed
+ *        input is exhausted
+ * @return Greengrass error code, GGE_INVALID_PARAMETER when the document is
+ *         malformed or a token is larger than max_token_size
+ */
+gg_error gg_json_reader_next(gg_json_reader reader, gg_json_token *token);
+
+/**
+ * @brief Skip ahead to the value at a path in the document
+ *
+ * Tokens before the value are consumed without being returned. For objects
+ * and arrays the begin token is returned, and the members can be read with
+ * gg_json_reader_next.
+ *
+ * @param reader Reader to read from
+ * @param path Null-terminated string of object keys and array indexes
+ *        separated by '.', e.g. "state.desired.mode" or "items.0.name"
+ * @param token Destination for the first token of the value,
+ *        GG_JSON_TOKEN_NONE when more input is needed, in which case the
+ *        search resumes on the next call with the same path, or
+ *        GG_JSON_TOKEN_END when path is not in the document
+ * @return Greengrass error code, GGE_INVALID_PARAMETER when the document is
+ *         malformed
+ */
+gg_error gg_json_reader_find(gg_json_reader reader, const char *path,
+                             gg_json_token *token);
+
+/**
+ * @brief Read the response of a request until the value at a path
+ *
+ * Same as **gg_json_reader_find()**, feeding the reader with gg_request_read
+ * chunks read into memory owned by the reader until the value is found or
+ * the response ends.
+ *
+ * This method does not reset reader. Before reading a new response the
+ * caller must pass a reader fresh from gg_json_reader_init or reset with
+ * gg_json_reader_reset. Without a reset, a later call continues the same
+ * response, so successive paths can be found in document order.
+ *
+ * The reader may have read part of the response past the returned token.
+ * The rest of the response must therefore be read through the reader, with
+ * gg_json_reader_next or further calls to this method. gg_request_read must
+ * not be called on ggreq afterwards, as it would skip the buffered bytes.
+ * Whatever is left unread is discarded by gg_request_close.
+ *
+ * @param reader Reader to read with, see above for resetting it
+ * @param ggreq Request whose response is read
+ * @param path Null-terminated string path of the value, see
+ *        gg_json_reader_find
+ * @param token Destination for the first token of the value, or
+ *        GG_JSON_TOKEN_END when path is not in the response
+ * @return Greengrass error code
+ */
+gg_error gg_json_reader_find_in_request(gg_json_reader reader,
+        gg_request ggreq, const char *path, gg_json_token *token);
+
 /***************************************
 **     AWS Secrets Manager Methods    **
 ***************************************/
@@ -326,6 +1447,7 @@ gg_error gg_publish_options_init(gg_publish_options *opts);
  * @brief Free a publish options that was created by gg_publish_options_init
  * @param opts Publish options to be freed
  * @return Greengrass error code
+ * @note opts must not be in use by any other thread
  */
 gg_error gg_publish_options_free(gg_publish_options opts);
 
@@ -334,10 +1456,101 @@ gg_error gg_publish_options_free(gg_publish_options opts);
  * @param opts Publish options to be configured
  * @param policy Selected queue full policy to be set
  * @return Greengrass error code
+ * @note Once configured, opts is read-only and may be passed to concurrent
+ *       gg_publish_with_options calls on any thread. Setters must not run
+ *       concurrently with those calls.
  */
 gg_error gg_publish_options_set_queue_full_policy(gg_publish_options opts,
         gg_queue_full_policy_options policy);
 
+/**
+ * @brief Open a spool that stores publishes rejected by a full queue
+ *
+ * The spool is an append-only ring in a memory mapped file. Publishes made
+ * with publish options that use the spool and rejected with
+ * GG_REQUEST_AGAIN are appended to it, and the call returns request status
+ * GG_REQUEST_SPOOLED instead. A background thread replays the spooled
+ * publishes in order once Greengrass Core accepts publishes again. Spooled
+ * publishes that were not delivered when the process stopped, including on a
+ * crash, are replayed when the same file is opened again.
+ *
+ * @param spool Pointer to spool to be opened
+ * @param path Null-terminated string path of the spool file, created when
+ *        missing. The directory must be writable by the lambda
+ * @param byte_budget Maximum size of the spooled topics and payloads
+ * @param policy What to do when a publish does not fit in byte_budget
+ * @return Greengrass error code
+ * @note Need to call gg_spool_close on spool when done using it. A spool
+ *       file must only be opened by one spool at a time.
+ */
+gg_error gg_spool_open(gg_spool *spool, const char *path, size_t byte_budget,
+        gg_spool_overflow_policy policy);
+
+/**
+ * @brief Close a spool that was opened by gg_spool_open
+ *
+ * Stops the background replay. Undelivered publishes stay in the spool file.
+ *
+ * @param spool Spool to be closed
+ * @return Greengrass error code
+ * @note spool must not be used by any publish options in use
+ */
+gg_error gg_spool_close(gg_spool spool);
+
+/**
+ * @brief Get the amount of publishes waiting in a spool
+ * @param spool Spool to be queried
+ * @param pending_count Destination for the number of spooled publishes
+ * @param pending_bytes Destination for the size of the spooled publishes
+ * @param dropped_count Destination for the number of publishes dropped by
+ *        GG_SPOOL_OVERFLOW_DROP_OLDEST since the spool was opened
+ * @return Greengrass error code
+ */
+gg_error gg_spool_get_pending(gg_spool spool, size_t *pending_count,
+        size_t *pending_bytes, uint64_t *dropped_count);
+
+/**
+ * @brief Sets the spool used for publishes rejected by a full queue
+ * @param opts Publish options to be configured
+ * @param spool Spool to be used, NULL to disable spooling. Only applies with
+ *        GG_QUEUE_FULL_POLICY_ALL_OR_ERROR
+ * @return Greengrass error code
+ * @note Spooled publishes are delivered after the call returns, so ordering
+ *       with later publishes on the same topic is kept only while they go
+ *       through the same spool.
+ */
+gg_error gg_publish_options_set_spool(gg_publish_options opts, gg_spool spool);
+
+/**
+ * @brief Enables suppression of publishes whose payload is unchanged
+ *
+ * The publish options keep a hash of the last payload sent per topic, or per
+ * thing for gg_update_thing_shadow_with_options. A call whose payload hashes
+ * the same as the last one sent returns request status GG_REQUEST_SUPPRESSED
+ * without contacting Greengrass Core, unless heartbeat_ms has elapsed since
+ * the last send. Calls that do not complete with GG_REQUEST_SUCCESS or
+ * GG_REQUEST_SPOOLED do not update the hash, so they are retried in full.
+ *
+ * A spooled publish counts as sent while it waits in the spool, so repeating
+ * it does not fill the spool with copies. When GG_SPOOL_OVERFLOW_DROP_OLDEST
+ * drops it before delivery, the hash of its topic is cleared, and the next
+ * publish to that topic is sent even if unchanged.
+ *
+ * @param opts Publish options to be configured
+ * @param heartbeat_ms Interval in milliseconds after which an unchanged
+ *        payload is sent anyway, 0 to disable suppression (the default)
+ * @return Greengrass error code
+ * @note The hashes belong to opts, so the same opts must be reused across
+ *       calls, e.g. created once at startup. They are updated internally and
+ *       opts may still be shared by concurrent calls.
+ * @note One hash is kept per distinct topic or thing name used with opts, and
+ *       they are only released by gg_publish_options_free. The number of
+ *       topics is not bounded, so do not enable suppression on options used
+ *       with an unbounded set of topics, e.g. ones embedding a request id.
+ */
+gg_error gg_publish_options_set_dedup(gg_publish_options opts,
+        uint32_t heartbeat_ms);
+
 /**
  * @brief Publish a payload to a topic
  * @param ggreq Provides context about the request
@@ -387,6 +1600,21 @@ gg_error gg_update_thing_shadow(gg_request ggreq, const char *thing_name,
                                 const char *update_payload,
                                 gg_request_result *result);
 
+/**
+ * @brief Update thing shadow for thing name
+ * @param ggreq Provides context about the request
+ * @param thing_name Null-terminated string specifying thing shadow to update
+ * @param update_payload Null-terminated string to be updated in the shadow
+ * @param opts Publish options, only the dedup setting applies
+ * @param result Describes the result of the request, request status
+ *        GG_REQUEST_SUPPRESSED when the update was skipped. There is no
+ *        response to read for a suppressed update
+ * @return Greengrass error code
+ */
+gg_error gg_update_thing_shadow_with_options(gg_request ggreq,
+        const char *thing_name, const char *update_payload,
+        const gg_publish_options opts, gg_request_result *result);
+
 /**
  * @brief Delete thing shadow for thing name
  * @param ggreq Provides context about the request
@@ -398,6 +1626,32 @@ gg_error gg_update_thing_shadow(gg_request ggreq, const char *thing_name,
 gg_error gg_delete_thing_shadow(gg_request ggreq, const char *thing_name,
                                 gg_request_result *result);
 
+/***************************************
+**  Token Exchange Service Methods    **
+***************************************/
+
+/**
+ * @brief Get AWS credentials from the Greengrass Token Exchange Service
+ *
+ * Credentials are fetched from the Token Exchange Service on first use and
+ * cached in the process. A background thread refreshes them 5 minutes before
+ * they expire, so calls after the first one return the cached credentials
+ * without any I/O or locking.
+ *
+ * @param credentials Destination for an immutable snapshot of the current
+ *        credentials, valid until released with gg_tes_credentials_release
+ * @return Greengrass error code
+ * @note Requires the lambda to be in a Greengrass group with a group role
+ */
+gg_error gg_tes_credentials_acquire(const gg_tes_credentials **credentials);
+
+/**
+ * @brief Release credentials returned by gg_tes_credentials_acquire
+ * @param credentials Credentials to be released
+ * @return Greengrass error code
+ */
+gg_error gg_tes_credentials_release(const gg_tes_credentials *credentials);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,8 +3,10 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "greengrasssdk.h"
+#include "greengrasssdk_probes.h"
 
 /*
  * In case the system loads the stub library instead of the true
@@ -19,8 +21,24 @@ static void print_loaded_stub_error() {
 ***************************************/
 
 gg_error gg_global_init(uint32_t opt) {
-    (void)opt;
+    GG_PROBE1(gg_global_init_entry, opt);
     print_loaded_stub_error();
+    GG_PROBE1(gg_global_init_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_global_init_with_allocator(uint32_t opt,
+                                       const gg_allocator *allocator) {
+    GG_PROBE2(gg_global_init_with_allocator_entry, opt, allocator);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_global_init_with_allocator_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_global_get_opt(uint32_t *opt) {
+    GG_PROBE1(gg_global_get_opt_entry, opt);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_global_get_opt_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
@@ -29,9 +47,43 @@ gg_error gg_global_init(uint32_t opt) {
 ***************************************/
 
 gg_error gg_log(gg_log_level level, const char *format, ...) {
-    (void)level;
-    (void)format;
+    GG_PROBE2(gg_log_entry, level, format);
     print_loaded_stub_error();
+    GG_PROBE1(gg_log_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_log_ratelimited(gg_log_ratelimit *ratelimit, gg_log_level level,
+                            const char *format, ...) {
+    GG_PROBE3(gg_log_ratelimited_entry, ratelimit, level, format);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_log_ratelimited_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_log_ratelimit_flush(void) {
+    GG_PROBE0(gg_log_ratelimit_flush_entry);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_log_ratelimit_flush_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+/***************************************
+**           Metrics Methods          **
+***************************************/
+
+gg_error gg_metrics_snapshot(gg_metrics_api api, gg_metrics_api_stats *stats) {
+    GG_PROBE2(gg_metrics_snapshot_entry, api, stats);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_metrics_snapshot_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_metrics_bucket_lower_bound(uint32_t bucket,
+                                       uint64_t *lower_bound_us) {
+    GG_PROBE2(gg_metrics_bucket_lower_bound_entry, bucket, lower_bound_us);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_metrics_bucket_lower_bound_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
@@ -40,24 +92,71 @@ gg_error gg_log(gg_log_level level, const char *format, ...) {
 ***************************************/
 
 gg_error gg_request_init(gg_request *ggreq) {
-    (void)ggreq;
+    GG_PROBE1(gg_request_init_entry, ggreq);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_request_init_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_request_init_with_arena(gg_arena arena, gg_request *ggreq) {
+    GG_PROBE2(gg_request_init_with_arena_entry, arena, ggreq);
     print_loaded_stub_error();
+    GG_PROBE1(gg_request_init_with_arena_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_request_close(gg_request ggreq) {
-    (void)ggreq;
+    GG_PROBE1(gg_request_close_entry, ggreq);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_request_close_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_request_set_timeout(gg_request ggreq, uint32_t timeout_ms) {
+    GG_PROBE2(gg_request_set_timeout_entry, ggreq, timeout_ms);
     print_loaded_stub_error();
+    GG_PROBE1(gg_request_set_timeout_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_request_set_priority(gg_request ggreq, uint32_t priority) {
+    GG_PROBE2(gg_request_set_priority_entry, ggreq, priority);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_request_set_priority_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_request_set_deadline(gg_request ggreq, uint32_t deadline_ms) {
+    GG_PROBE2(gg_request_set_deadline_entry, ggreq, deadline_ms);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_request_set_deadline_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_request_cancel(gg_request ggreq) {
+    GG_PROBE1(gg_request_cancel_entry, ggreq);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_request_cancel_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_request_read(gg_request ggreq, void *buffer, size_t buffer_size,
                          size_t *amount_read) {
-    (void)ggreq;
+    GG_PROBE2(gg_request_read_entry, ggreq, buffer_size);
     (void)buffer;
-    (void)buffer_size;
     (void)amount_read;
     print_loaded_stub_error();
+    GG_PROBE1(gg_request_read_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_request_read_mapped(gg_request ggreq, const void **response,
+                                size_t *response_size) {
+    GG_PROBE1(gg_request_read_mapped_entry, ggreq);
+    (void)response;
+    (void)response_size;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_request_read_mapped_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
@@ -66,32 +165,388 @@ gg_error gg_request_read(gg_request ggreq, void *buffer, size_t buffer_size,
 ***************************************/
 
 gg_error gg_runtime_start(gg_lambda_handler handler, uint32_t opt) {
-    (void)handler;
-    (void)opt;
+    GG_PROBE2(gg_runtime_start_entry, handler, opt);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_start_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_start_with_options(gg_lambda_handler handler,
+        uint32_t opt, const gg_runtime_options opts) {
+    GG_PROBE3(gg_runtime_start_with_options_entry, handler, opt, opts);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_start_with_options_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_start_batch(gg_lambda_batch_handler handler,
+        uint32_t opt, const gg_runtime_options opts) {
+    GG_PROBE3(gg_runtime_start_batch_entry, handler, opt, opts);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_start_batch_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_init(gg_runtime_options *opts) {
+    GG_PROBE1(gg_runtime_options_init_entry, opts);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_init_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_free(gg_runtime_options opts) {
+    GG_PROBE1(gg_runtime_options_free_entry, opts);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_free_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_worker_count(gg_runtime_options opts,
+        uint32_t worker_count) {
+    GG_PROBE2(gg_runtime_options_set_worker_count_entry, opts, worker_count);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_worker_count_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_add_topic_handler(gg_runtime_options opts,
+        const char *topic_filter, gg_lambda_handler handler) {
+    GG_PROBE3(gg_runtime_options_add_topic_handler_entry,
+            opts, topic_filter, handler);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_add_topic_handler_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_init_callback(gg_runtime_options opts,
+        gg_init_callback callback) {
+    GG_PROBE2(gg_runtime_options_set_init_callback_entry, opts, callback);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_init_callback_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_drain_timeout(gg_runtime_options opts,
+        uint32_t timeout_ms) {
+    GG_PROBE2(gg_runtime_options_set_drain_timeout_entry, opts, timeout_ms);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_drain_timeout_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_shutdown_callback(gg_runtime_options opts,
+        gg_shutdown_callback callback) {
+    GG_PROBE2(gg_runtime_options_set_shutdown_callback_entry, opts, callback);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_shutdown_callback_return,
+            GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_user_data(gg_runtime_options opts,
+        void *user_data) {
+    GG_PROBE2(gg_runtime_options_set_user_data_entry, opts, user_data);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_user_data_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_prefetch_count(gg_runtime_options opts,
+        uint32_t prefetch_count) {
+    GG_PROBE2(gg_runtime_options_set_prefetch_count_entry,
+            opts, prefetch_count);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_prefetch_count_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_dispatch_order(gg_runtime_options opts,
+        gg_dispatch_order order) {
+    GG_PROBE2(gg_runtime_options_set_dispatch_order_entry, opts, order);
     print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_dispatch_order_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_max_batch_size(gg_runtime_options opts,
+        uint32_t max_batch_size) {
+    GG_PROBE2(gg_runtime_options_set_max_batch_size_entry,
+            opts, max_batch_size);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_max_batch_size_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_thread_affinity(gg_runtime_options opts,
+        gg_thread_role role, const uint32_t *cpus, size_t cpu_count) {
+    GG_PROBE3(gg_runtime_options_set_thread_affinity_entry,
+            opts, role, cpu_count);
+    (void)cpus;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_thread_affinity_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_thread_scheduling(gg_runtime_options opts,
+        gg_thread_role role, int policy, int priority) {
+    GG_PROBE4(gg_runtime_options_set_thread_scheduling_entry,
+            opts, role, policy, priority);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_thread_scheduling_return,
+            GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_runtime_options_set_thread_name(gg_runtime_options opts,
+        gg_thread_role role, const char *name) {
+    GG_PROBE3(gg_runtime_options_set_thread_name_entry, opts, role, name);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_runtime_options_set_thread_name_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_lambda_handler_read(void *buffer, size_t buffer_size,
                                 size_t *amount_read) {
+    GG_PROBE1(gg_lambda_handler_read_entry, buffer_size);
     (void)buffer;
-    (void)buffer_size;
     (void)amount_read;
     print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_handler_read_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_handler_read_mapped(const void **payload,
+                                       size_t *payload_size) {
+    GG_PROBE0(gg_lambda_handler_read_mapped_entry);
+    (void)payload;
+    (void)payload_size;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_handler_read_mapped_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_lambda_handler_write_response(const void *response,
                                           size_t response_size) {
+    GG_PROBE1(gg_lambda_handler_write_response_entry, response_size);
     (void)response;
-    (void)response_size;
     print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_handler_write_response_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_lambda_handler_write_error(const char *error_message) {
-    (void)error_message;
+    GG_PROBE1(gg_lambda_handler_write_error_entry, error_message);
     print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_handler_write_error_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_handler_detach(gg_lambda_completion *completion) {
+    GG_PROBE1(gg_lambda_handler_detach_entry, completion);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_handler_detach_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_completion_write_response(gg_lambda_completion completion,
+        const void *response, size_t response_size) {
+    GG_PROBE2(gg_lambda_completion_write_response_entry,
+            completion, response_size);
+    (void)response;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_completion_write_response_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_completion_write_error(gg_lambda_completion completion,
+        const char *error_message) {
+    GG_PROBE2(gg_lambda_completion_write_error_entry,
+            completion, error_message);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_completion_write_error_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_batch_write_response(size_t index, const void *response,
+                                        size_t response_size) {
+    GG_PROBE2(gg_lambda_batch_write_response_entry, index, response_size);
+    (void)response;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_batch_write_response_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_batch_write_error(size_t index, const char *error_message) {
+    GG_PROBE2(gg_lambda_batch_write_error_entry, index, error_message);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_batch_write_error_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_context_get_arena(const gg_lambda_context *cxt,
+        gg_arena *arena) {
+    GG_PROBE1(gg_lambda_context_get_arena_entry, cxt);
+    (void)arena;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_context_get_arena_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_context_get_user_data(const gg_lambda_context *cxt,
+        void **user_data) {
+    GG_PROBE1(gg_lambda_context_get_user_data_entry, cxt);
+    (void)user_data;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_context_get_user_data_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_context_get_topic(const gg_lambda_context *cxt,
+        const char **topic, const char *const **wildcards,
+        size_t *wildcard_count) {
+    GG_PROBE1(gg_lambda_context_get_topic_entry, cxt);
+    (void)topic;
+    (void)wildcards;
+    (void)wildcard_count;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_context_get_topic_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_context_get_priority(const gg_lambda_context *cxt,
+        uint32_t *priority) {
+    GG_PROBE1(gg_lambda_context_get_priority_entry, cxt);
+    (void)priority;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_context_get_priority_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_context_get_deadline(const gg_lambda_context *cxt,
+        uint32_t *deadline_ms, int64_t *dispatch_lateness_us) {
+    GG_PROBE1(gg_lambda_context_get_deadline_entry, cxt);
+    (void)deadline_ms;
+    (void)dispatch_lateness_us;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_context_get_deadline_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_context_get_client_context(const gg_lambda_context *cxt,
+        const char **json, size_t *json_size) {
+    GG_PROBE1(gg_lambda_context_get_client_context_entry, cxt);
+    (void)json;
+    (void)json_size;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_context_get_client_context_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_lambda_context_get_client_context_value(
+        const gg_lambda_context *cxt, const char *path, const char **value,
+        size_t *value_size) {
+    GG_PROBE2(gg_lambda_context_get_client_context_value_entry, cxt, path);
+    (void)value;
+    (void)value_size;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_lambda_context_get_client_context_value_return,
+            GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_arena_alloc(gg_arena arena, size_t size, size_t alignment,
+                        void **ptr) {
+    GG_PROBE3(gg_arena_alloc_entry, arena, size, alignment);
+    (void)ptr;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_arena_alloc_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+/***************************************
+**          Encoding Methods          **
+***************************************/
+
+gg_error gg_base64_encode(const void *data, size_t data_size, char *buffer,
+                          size_t buffer_size, size_t *amount_written) {
+    GG_PROBE2(gg_base64_encode_entry, data_size, buffer_size);
+    (void)data;
+    (void)buffer;
+    (void)amount_written;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_base64_encode_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_base64_decode(const char *encoded, size_t encoded_size,
+                          void *buffer, size_t buffer_size,
+                          size_t *amount_written) {
+    GG_PROBE2(gg_base64_decode_entry, encoded_size, buffer_size);
+    (void)encoded;
+    (void)buffer;
+    (void)amount_written;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_base64_decode_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+/***************************************
+**            JSON Methods            **
+***************************************/
+
+gg_error gg_json_reader_init(gg_json_reader *reader, size_t max_token_size) {
+    GG_PROBE2(gg_json_reader_init_entry, reader, max_token_size);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_json_reader_init_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_json_reader_free(gg_json_reader reader) {
+    GG_PROBE1(gg_json_reader_free_entry, reader);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_json_reader_free_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_json_reader_reset(gg_json_reader reader) {
+    GG_PROBE1(gg_json_reader_reset_entry, reader);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_json_reader_reset_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_json_reader_feed(gg_json_reader reader, const void *chunk,
+                             size_t chunk_size) {
+    GG_PROBE2(gg_json_reader_feed_entry, reader, chunk_size);
+    (void)chunk;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_json_reader_feed_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_json_reader_next(gg_json_reader reader, gg_json_token *token) {
+    GG_PROBE1(gg_json_reader_next_entry, reader);
+    (void)token;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_json_reader_next_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_json_reader_find(gg_json_reader reader, const char *path,
+                             gg_json_token *token) {
+    GG_PROBE2(gg_json_reader_find_entry, reader, path);
+    (void)token;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_json_reader_find_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_json_reader_find_in_request(gg_json_reader reader,
+        gg_request ggreq, const char *path, gg_json_token *token) {
+    GG_PROBE3(gg_json_reader_find_in_request_entry, reader, ggreq, path);
+    (void)token;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_json_reader_find_in_request_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
@@ -102,12 +557,11 @@ gg_error gg_lambda_handler_write_error(const char *error_message) {
 gg_error gg_get_secret_value(gg_request ggreq, const char *secret_id,
                              const char *version_id, const char *version_stage,
                              gg_request_result *result) {
-    (void)ggreq;
-    (void)secret_id;
-    (void)version_id;
-    (void)version_stage;
+    GG_PROBE4(gg_get_secret_value_entry,
+            ggreq, secret_id, version_id, version_stage);
     (void)result;
     print_loaded_stub_error();
+    GG_PROBE1(gg_get_secret_value_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
@@ -117,10 +571,12 @@ gg_error gg_get_secret_value(gg_request ggreq, const char *secret_id,
 
 gg_error gg_invoke(gg_request ggreq, const gg_invoke_options *opts,
                    gg_request_result *result) {
-    (void)ggreq;
-    (void)opts;
+    GG_PROBE3(gg_invoke_entry,
+            ggreq, opts ? opts->function_arn : NULL,
+            opts ? opts->payload_size : 0);
     (void)result;
     print_loaded_stub_error();
+    GG_PROBE1(gg_invoke_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
@@ -129,74 +585,144 @@ gg_error gg_invoke(gg_request ggreq, const gg_invoke_options *opts,
 ***************************************/
 
 gg_error gg_publish_options_init(gg_publish_options *opts) {
-    (void)opts;
+    GG_PROBE1(gg_publish_options_init_entry, opts);
     print_loaded_stub_error();
+    GG_PROBE1(gg_publish_options_init_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_publish_options_free(gg_publish_options opts) {
-    (void)opts;
+    GG_PROBE1(gg_publish_options_free_entry, opts);
     print_loaded_stub_error();
+    GG_PROBE1(gg_publish_options_free_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_publish_options_set_queue_full_policy(gg_publish_options opts,
         gg_queue_full_policy_options policy) {
-    (void)opts;
-    (void)policy;
+    GG_PROBE2(gg_publish_options_set_queue_full_policy_entry, opts, policy);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_publish_options_set_queue_full_policy_return,
+            GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_spool_open(gg_spool *spool, const char *path, size_t byte_budget,
+        gg_spool_overflow_policy policy) {
+    GG_PROBE4(gg_spool_open_entry, spool, path, byte_budget, policy);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_spool_open_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_spool_close(gg_spool spool) {
+    GG_PROBE1(gg_spool_close_entry, spool);
     print_loaded_stub_error();
+    GG_PROBE1(gg_spool_close_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_spool_get_pending(gg_spool spool, size_t *pending_count,
+        size_t *pending_bytes, uint64_t *dropped_count) {
+    GG_PROBE1(gg_spool_get_pending_entry, spool);
+    (void)pending_count;
+    (void)pending_bytes;
+    (void)dropped_count;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_spool_get_pending_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_publish_options_set_spool(gg_publish_options opts, gg_spool spool) {
+    GG_PROBE2(gg_publish_options_set_spool_entry, opts, spool);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_publish_options_set_spool_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_publish_options_set_dedup(gg_publish_options opts,
+        uint32_t heartbeat_ms) {
+    GG_PROBE2(gg_publish_options_set_dedup_entry, opts, heartbeat_ms);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_publish_options_set_dedup_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_publish_with_options(gg_request ggreq, const char *topic,
         const void *payload, size_t payload_size, const gg_publish_options opts,
         gg_request_result *result) {
-    (void)ggreq;
-    (void)topic;
+    GG_PROBE4(gg_publish_with_options_entry, ggreq, topic, payload_size, opts);
     (void)payload;
-    (void)payload_size;
-    (void)opts;
     (void)result;
     print_loaded_stub_error();
+    GG_PROBE1(gg_publish_with_options_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_publish(gg_request ggreq, const char *topic, const void *payload,
                     size_t payload_size, gg_request_result *result) {
-    (void)ggreq;
-    (void)topic;
+    GG_PROBE3(gg_publish_entry, ggreq, topic, payload_size);
     (void)payload;
-    (void)payload_size;
     (void)result;
     print_loaded_stub_error();
+    GG_PROBE1(gg_publish_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_get_thing_shadow(gg_request ggreq, const char *thing_name,
                              gg_request_result *result) {
-    (void)ggreq;
-    (void)thing_name;
+    GG_PROBE2(gg_get_thing_shadow_entry, ggreq, thing_name);
     (void)result;
     print_loaded_stub_error();
+    GG_PROBE1(gg_get_thing_shadow_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_update_thing_shadow(gg_request ggreq, const char *thing_name,
                                 const char *update_payload,
                                 gg_request_result *result) {
-    (void)ggreq;
-    (void)thing_name;
-    (void)update_payload;
+    GG_PROBE3(gg_update_thing_shadow_entry, ggreq, thing_name,
+            update_payload ? strlen(update_payload) : 0);
     (void)result;
     print_loaded_stub_error();
+    GG_PROBE1(gg_update_thing_shadow_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_update_thing_shadow_with_options(gg_request ggreq,
+        const char *thing_name, const char *update_payload,
+        const gg_publish_options opts, gg_request_result *result) {
+    GG_PROBE4(gg_update_thing_shadow_with_options_entry, ggreq, thing_name,
+            update_payload ? strlen(update_payload) : 0, opts);
+    (void)result;
+    print_loaded_stub_error();
+    GG_PROBE1(gg_update_thing_shadow_with_options_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
 
 gg_error gg_delete_thing_shadow(gg_request ggreq, const char *thing_name,
                                 gg_request_result *result) {
-    (void)ggreq;
-    (void)thing_name;
+    GG_PROBE2(gg_delete_thing_shadow_entry, ggreq, thing_name);
     (void)result;
     print_loaded_stub_error();
+    GG_PROBE1(gg_delete_thing_shadow_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+/***************************************
+**  Token Exchange Service Methods    **
+***************************************/
+
+gg_error gg_tes_credentials_acquire(const gg_tes_credentials **credentials) {
+    GG_PROBE1(gg_tes_credentials_acquire_entry, credentials);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_tes_credentials_acquire_return, GGE_RESERVED_MAX);
+    return GGE_RESERVED_MAX;
+}
+
+gg_error gg_tes_credentials_release(const gg_tes_credentials *credentials) {
+    GG_PROBE1(gg_tes_credentials_release_entry, credentials);
+    print_loaded_stub_error();
+    GG_PROBE1(gg_tes_credentials_release_return, GGE_RESERVED_MAX);
     return GGE_RESERVED_MAX;
 }
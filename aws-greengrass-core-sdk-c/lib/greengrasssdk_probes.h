@@ -0,0 +1,65 @@
+/*
+ * Copyright 2018 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ */
+
+/*
+ * Static user space probes (USDT) under the provider "greengrasssdk".
+ *
+ * Every function declared in greengrasssdk.h fires "<function>_entry" when it
+ * is called and "<function>_return" with the returned gg_error. Entry probes
+ * carry the request handle, which serves as the request id, followed by the
+ * topic, thing name, secret id, function ARN or error message and the payload
+ * size where the function has them. Payloads are never passed to probes,
+ * only their size in bytes, e.g. strlen(update_payload) for shadow updates.
+ *
+ * The implementation library additionally fires these transport probes:
+ *   transport_send(request, size)      a frame is written to Greengrass Core
+ *   transport_receive(request, size)   a frame is read from Greengrass Core
+ *   transport_queue_full(request, topic)
+ *                                      Greengrass Core rejected a publish
+ *                                      because its queue was full
+ *
+ * A probe is a single nop until a tracer such as perf or bpftrace attaches
+ * to it, e.g.
+ *   bpftrace -e 'usdt:libaws-greengrass-core-sdk-c.so:greengrasssdk:gg_publish_entry
+ *       { printf("%s %d\n", str(arg1), arg2); }'
+ * This header is the probe contract of the implementation library shipped
+ * with Greengrass Core; the stub built from this tree uses the same macros
+ * only to keep it in line. Without a usable sys/sdt.h the probes compile to
+ * nothing.
+ */
+
+#ifndef _GREENGRASS_SDK_PROBES_H_
+#define _GREENGRASS_SDK_PROBES_H_
+
+#ifdef GG_HAVE_SYS_SDT_H
+
+#include <sys/sdt.h>
+
+#define GG_PROBE0(name) \
+    DTRACE_PROBE(greengrasssdk, name)
+#define GG_PROBE1(name, a1) \
+    DTRACE_PROBE1(greengrasssdk, name, a1)
+#define GG_PROBE2(name, a1, a2) \
+    DTRACE_PROBE2(greengrasssdk, name, a1, a2)
+#define GG_PROBE3(name, a1, a2, a3) \
+    DTRACE_PROBE3(greengrasssdk, name, a1, a2, a3)
+#define GG_PROBE4(name, a1, a2, a3, a4) \
+    DTRACE_PROBE4(greengrasssdk, name, a1, a2, a3, a4)
+
+#else
+
+#define GG_PROBE0(name) \
+    ((void)0)
+#define GG_PROBE1(name, a1) \
+    ((void)(a1))
+#define GG_PROBE2(name, a1, a2) \
+    ((void)(a1), (void)(a2))
+#define GG_PROBE3(name, a1, a2, a3) \
+    ((void)(a1), (void)(a2), (void)(a3))
+#define GG_PROBE4(name, a1, a2, a3, a4) \
+    ((void)(a1), (void)(a2), (void)(a3), (void)(a4))
+
+#endif /* #ifdef GG_HAVE_SYS_SDT_H */
+
+#endif /* #ifndef _GREENGRASS_SDK_PROBES_H_ */